@@ -54,12 +54,19 @@ from .core.calldata import (
     set_print_generated_shaders,
 )
 
+# Persistent kernel cache
+from .core.kernelcache import set_kernel_cache_path
+
+# Background kernel precompilation
+from .core.precompile import wait_for_precompiles
+
 # Core slangpy interface
 from .core.function import Function
 from .core.struct import Struct
 from .core.module import Module
 from .core.instance import InstanceList, InstanceBuffer
 from .core.packedarg import pack
+from .core.callbatch import CallBatch
 
 # Py torch integration
 from .torchintegration import *
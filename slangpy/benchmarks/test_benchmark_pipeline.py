@@ -0,0 +1,56 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+
+import slangpy as spy
+from slangpy.testing import helpers
+from slangpy.testing.benchmark import BenchmarkPythonFunction
+
+PIPELINE_COUNT = 16
+
+KERNEL = """
+[shader("compute")]
+[numthreads(32, 1, 1)]
+void kernel_{index}(uint3 tid: SV_DispatchThreadID, RWStructuredBuffer<float> res) {{
+    float x = float(tid.x);
+    for (uint i = 0; i < {index} + 16; ++i)
+        x = sin(x) * {seed}.0 + cos(x * {index}.0);
+    res[tid.x] = x;
+}}
+"""
+
+
+# All pipelines come from one session. Batched creation generates the target code serially and
+# then creates the pipelines in parallel, so it should beat creating them one at a time.
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("batched", [False, True])
+def test_create_compute_pipelines(
+    device_type: spy.DeviceType, batched: bool, benchmark_python_function: BenchmarkPythonFunction
+):
+    device = helpers.get_device(device_type)
+    seed = 0
+
+    def create():
+        # Use new source in a new session every time, so nothing is served from a cache.
+        nonlocal seed
+        seed += 1
+        source = "".join(KERNEL.format(index=i, seed=seed) for i in range(PIPELINE_COUNT))
+        session = device.create_slang_session()
+        module = session.load_module_from_source(f"pipeline_benchmark_{seed}", source)
+        programs = session.link_programs(
+            [
+                {"modules": [module], "entry_points": [module.entry_point(f"kernel_{i}")]}
+                for i in range(PIPELINE_COUNT)
+            ]
+        )
+        if batched:
+            device.create_compute_pipelines([{"program": x} for x in programs])
+        else:
+            for program in programs:
+                device.create_compute_pipeline(program)
+
+    benchmark_python_function(device, create, iterations=5, sub_iterations=1, warmup_iterations=1)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
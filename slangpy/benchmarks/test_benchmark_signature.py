@@ -0,0 +1,66 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+from typing import Any
+import pytest
+
+import slangpy as spy
+from slangpy.core.native import NativeCallData, NativeCallDataCache, SignatureBuilder
+from slangpy.testing import helpers
+from slangpy.testing.benchmark import BenchmarkPythonFunction
+
+ARG_COUNTS = [1, 4, 16, 64]
+
+
+def make_args(device: spy.Device, arg_count: int) -> tuple[list[Any], dict[str, Any]]:
+    """Build a representative mix of scalars, buffers and dicts for signature generation."""
+    buffer = device.create_buffer(size=256, usage=spy.BufferUsage.shader_resource)
+    ndbuffer = spy.NDBuffer.empty(device, shape=(16,), dtype=float)
+    values = [1, 2.0, buffer, ndbuffer, {"x": 1, "y": 2.0}]
+    args = [values[i % len(values)] for i in range(arg_count)]
+    kwargs = {f"arg{i}": values[i % len(values)] for i in range(arg_count // 2)}
+    return args, kwargs
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("arg_count", ARG_COUNTS)
+def test_signature_build(
+    device_type: spy.DeviceType, arg_count: int, benchmark_python_function: BenchmarkPythonFunction
+):
+    device = helpers.get_device(device_type)
+    cache = NativeCallDataCache()
+    args, kwargs = make_args(device, arg_count)
+
+    def build():
+        builder = SignatureBuilder()
+        cache.get_args_signature(builder, *args, **kwargs)
+
+    benchmark_python_function(device, build)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("arg_count", ARG_COUNTS)
+def test_signature_lookup(
+    device_type: spy.DeviceType, arg_count: int, benchmark_python_function: BenchmarkPythonFunction
+):
+    device = helpers.get_device(device_type)
+    cache = NativeCallDataCache()
+    args, kwargs = make_args(device, arg_count)
+
+    # Populate the cache with the signature being looked up plus some unrelated entries.
+    builder = SignatureBuilder()
+    cache.get_args_signature(builder, *args, **kwargs)
+    call_data = NativeCallData()
+    cache.add_call_data(builder, call_data)
+    for i in range(256):
+        cache.add_call_data(f"unrelated_{i}", NativeCallData())
+
+    def lookup():
+        builder = SignatureBuilder()
+        cache.get_args_signature(builder, *args, **kwargs)
+        assert cache.find_call_data(builder) is call_data
+
+    benchmark_python_function(device, lookup)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
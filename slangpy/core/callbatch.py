@@ -0,0 +1,39 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+from typing import TYPE_CHECKING, Any, Optional
+
+from slangpy.core.native import NativeCallBatch
+from slangpy import Device, NativeHandle
+
+if TYPE_CHECKING:
+    from slangpy.core.function import FunctionNode
+
+
+class CallBatch(NativeCallBatch):
+    """
+    Collects many function calls and dispatches them together. All calls are encoded
+    into a single compute pass and submitted once, after which call data and return
+    values are read back for every call.
+
+    Ray tracing calls, calls with their own CUDA stream and torch integrated calls
+    cannot be batched.
+    """
+
+    def __init__(self, device: Device):
+        super().__init__(device)
+
+    def add(self, func: "FunctionNode", *args: Any, **kwargs: Any) -> int:
+        """
+        Add a call to the batch, generating and compiling a new kernel if need be.
+        Arguments are prepared immediately, so any output buffers are allocated here.
+        Returns the index of the call's result in the list returned by `submit`.
+        """
+        return func.append_to_batch(self, *args, **kwargs)
+
+    def submit(self, cuda_stream: Optional[NativeHandle] = None) -> list[Any]:
+        """
+        Dispatch all pending calls in a single command buffer and return their results
+        in the order they were added. The batch is empty afterwards and can be reused.
+        """
+        if cuda_stream is None:
+            return super().submit()
+        return super().submit(cuda_stream)
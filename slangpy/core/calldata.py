@@ -6,7 +6,9 @@ from pathlib import Path
 from typing import TYPE_CHECKING, Any, cast
 
 from slangpy.core.callsignature import *
+from slangpy.core.kernelcache import KernelCacheEntry, get_kernel_cache
 from slangpy.core.logging import bound_call_table, bound_exception_info, mismatch_info
+from slangpy.core.precompile import is_precompiling
 from slangpy.core.native import (
     CallMode,
     CallDataMode,
@@ -237,24 +239,48 @@ class CallData(NativeCallData):
             # Calculate differentiability of all variables.
             calculate_differentiability(context, bindings)
 
-            # Generate code.
-            codegen = CodeGen()
-            generate_code(context, build_info, bindings, codegen)
-            for link in build_info.module.link:
-                codegen.add_import(link.name)
-            code = codegen.finish(
-                call_data=True,
-                input_load_store=True,
-                header=True,
-                kernel=True,
-                imports=True,
-                trampoline=True,
-                context=True,
-                snippets=True,
-                call_data_structs=True,
-                constants=True,
-                use_param_block_for_call_data=context.call_data_mode == CallDataMode.global_data,
-            )
+            # Look up the generated kernel in the persistent kernel cache.
+            kernel_cache = get_kernel_cache()
+            kernel_cache_key = None
+            cached_kernel = None
+            if kernel_cache is not None:
+                kernel_cache_key = kernel_cache.key(function, build_info.module, args, kwargs)
+                if kernel_cache_key is not None:
+                    cached_kernel = kernel_cache.get(kernel_cache_key)
+
+            if cached_kernel is not None:
+                self.log_debug(f"  Found cached kernel with hash {cached_kernel.hash}")
+                code = cached_kernel.code
+                hash = cached_kernel.hash
+            else:
+                # Generate code.
+                codegen = CodeGen()
+                generate_code(context, build_info, bindings, codegen)
+                for link in build_info.module.link:
+                    codegen.add_import(link.name)
+                code = codegen.finish(
+                    call_data=True,
+                    input_load_store=True,
+                    header=True,
+                    kernel=True,
+                    imports=True,
+                    trampoline=True,
+                    context=True,
+                    snippets=True,
+                    call_data_structs=True,
+                    constants=True,
+                    use_param_block_for_call_data=context.call_data_mode == CallDataMode.global_data,
+                )
+
+                # Hash the code to get a unique identifier for the module.
+                # We add type conformances to the start of the code to ensure that the hash is unique
+                assert function.slangpy_signature is not None
+                code_minus_header = (
+                    "[CallData]\n"
+                    + str(build_info.type_conformances)
+                    + code[len(codegen.header) :]
+                )
+                hash = hashlib.sha256(code_minus_header.encode()).hexdigest()
 
             # Optionally write the shader to a file for debugging.
             sanitized = ""
@@ -302,14 +328,6 @@ class CallData(NativeCallData):
                 print("=" * 80)
                 print()
 
-            # Hash the code to get a unique identifier for the module.
-            # We add type conformances to the start of the code to ensure that the hash is unique
-            assert function.slangpy_signature is not None
-            code_minus_header = (
-                "[CallData]\n" + str(build_info.type_conformances) + code[len(codegen.header) :]
-            )
-            hash = hashlib.sha256(code_minus_header.encode()).hexdigest()
-
             # Check if we've already built this module.
             if hash in build_info.module.pipeline_cache:
                 # Get pipeline from cache if we have
@@ -325,10 +343,15 @@ class CallData(NativeCallData):
                 self.log_debug(f"  Building new pipeline with hash {hash}")
                 session = build_info.module.session
                 device = session.device
-                module = session.load_module_from_source(hash, code)
+                if cached_kernel is not None:
+                    module = session.load_module_from_serialized(hash, cached_kernel.module, code)
+                else:
+                    module = session.load_module_from_source(hash, code)
                 opts = SlangLinkOptions()
                 opts.dump_intermediates = _DUMP_SLANG_INTERMEDIATES
                 opts.dump_intermediates_prefix = sanitized
+                # Precompiled kernels compile target code up front, so the first call doesn't stall.
+                defer_target_compilation = not is_precompiling()
                 if build_info.pipeline_type == PipelineType.compute:
                     # Create compute pipeline
                     ep = module.entry_point(f"compute_main", type_conformances)
@@ -339,7 +362,7 @@ class CallData(NativeCallData):
                     )
                     self.pipeline = device.create_compute_pipeline(
                         program,
-                        defer_target_compilation=True,
+                        defer_target_compilation=defer_target_compilation,
                         label=f"{build_info.module.name}_{build_info.name}_compute_call",
                     )
                     build_info.module.pipeline_cache[hash] = self.pipeline
@@ -382,7 +405,7 @@ class CallData(NativeCallData):
                         max_ray_payload_size=build_info.ray_tracing_max_ray_payload_size,
                         max_attribute_size=build_info.ray_tracing_max_attribute_size,
                         flags=build_info.ray_tracing_flags,
-                        defer_target_compilation=True,
+                        defer_target_compilation=defer_target_compilation,
                         label=f"{build_info.module.name}_{build_info.name}_rt_call",
                     )
                     build_info.module.pipeline_cache[hash] = self.pipeline
@@ -399,6 +422,16 @@ class CallData(NativeCallData):
                 self.device = device
                 self.log_debug(f"  Build succesful")
 
+                # Store the kernel in the persistent kernel cache.
+                # Failing to store the kernel is not an error, it is just rebuilt next time.
+                if kernel_cache_key is not None and cached_kernel is None:
+                    assert kernel_cache is not None
+                    try:
+                        entry = KernelCacheEntry(hash, code, module.serialize())
+                        kernel_cache.set(kernel_cache_key, entry)
+                    except Exception as e:
+                        self.log_debug(f"  Failed to store kernel in kernel cache: {e}")
+
             # Store the bindings and runtime for later use.
             self.debug_only_bindings = bindings
             self.runtime = BoundCallRuntime(bindings)
@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 from typing import TYPE_CHECKING, Any, Callable, Optional, Protocol, Union, cast, Sequence
+from concurrent.futures import Future, wait
 from enum import Enum
 
 from slangpy.core.native import (
@@ -10,6 +11,7 @@ from slangpy.core.native import (
     FunctionNodeType,
 )
 
+from slangpy.core.precompile import submit_precompile
 from slangpy.reflection import SlangFunction, SlangType
 from slangpy import (
     CommandEncoder,
@@ -26,6 +28,7 @@ from slangpy.bindings.typeregistry import PYTHON_SIGNATURES
 
 if TYPE_CHECKING:
     from slangpy.core.calldata import CallData
+    from slangpy.core.callbatch import CallBatch
     from slangpy.core.module import Module
     from slangpy.core.struct import Struct
     from slangpy import HitGroupDescParam
@@ -87,6 +90,10 @@ class FunctionBuildInfo:
 
 
 class FunctionNode(NativeFunctionNode):
+    #: False if the signature of this node identifies a live object, so calls through it can not
+    #: be stored in the persistent kernel cache.
+    kernel_cacheable = True
+
     @property
     def root(self):
         """
@@ -257,6 +264,72 @@ class FunctionNode(NativeFunctionNode):
             self._native_build_call_data(self.module.call_data_cache, *args, **kwargs),
         )
 
+    def precompile(self, *args: Any, **kwargs: Any) -> "Future[Any]":
+        """
+        Generate and compile the kernel for a call with the given arguments on a background
+        thread, without dispatching it. The arguments only need to match the types (and for
+        buffers/tensors the element type and dimensionality) of the arguments of later calls.
+        A matching call made before the returned future completes waits for it, use `is_ready`
+        to check without blocking.
+
+        Arguments are values, not type descriptions: the call signature and the marshalls that
+        generate the kernel are derived from values by the same code as a call, so that the
+        kernel is guaranteed to match. A small stand-in works for any size, e.g. an NDBuffer of
+        shape (1,) for all 1D buffers of the same element type.
+        """
+        resval = kwargs.get("_result", None)
+        if isinstance(resval, (type, str)):
+            del kwargs["_result"]
+            return self.return_type(resval).precompile(*args, **kwargs)
+
+        key = self._call_signature(args, kwargs).bytes
+        futures = self.module._precompile_futures
+        future = futures.get(key)
+        if future is not None:
+            return future
+
+        # Capture the cache, so a kernel finishing after a hot reload doesn't end up in the
+        # new cache.
+        cache = self.module.call_data_cache
+        future = submit_precompile(lambda: self._native_build_call_data(cache, *args, **kwargs))
+        futures[key] = future
+        future.add_done_callback(lambda _: futures.pop(key, None))
+        return future
+
+    def is_ready(self, *args: Any, **kwargs: Any) -> bool:
+        """
+        Check without blocking whether the kernel for a call with the given arguments has been
+        built, i.e. whether calling the function would not generate or compile a kernel.
+        """
+        resval = kwargs.get("_result", None)
+        if isinstance(resval, (type, str)):
+            del kwargs["_result"]
+            return self.return_type(resval).is_ready(*args, **kwargs)
+
+        builder = self._call_signature(args, kwargs)
+        if builder.bytes in self.module._precompile_futures:
+            return False
+        return self.module.call_data_cache.find_call_data(builder) is not None
+
+    def _call_signature(self, args: Any, kwargs: Any) -> SignatureBuilder:
+        opts = NativeCallRuntimeOptions()
+        self.gather_runtime_options(opts)
+        if opts._native_this is not None:
+            args = (opts._native_this,) + tuple(args)
+        builder = SignatureBuilder()
+        self.read_signature(builder)
+        self.module.call_data_cache.get_args_signature(builder, *args, **kwargs)
+        return builder
+
+    def _wait_for_precompile(self, args: Any, kwargs: Any):
+        # Only pay for calculating the signature while precompiles are pending.
+        futures = self.module._precompile_futures
+        if futures:
+            future = futures.get(self._call_signature(args, kwargs).bytes)
+            if future is not None:
+                # Failed precompiles are ignored, the call rebuilds the kernel and reports errors.
+                wait([future])
+
     def call(self, *args: Any, **kwargs: Any) -> Any:
         """
         Call the function with a given set of arguments. This will generate and compile
@@ -282,6 +355,7 @@ class FunctionNode(NativeFunctionNode):
                     )
                 return self.append_to(app_to, *args, **kwargs)
 
+        self._wait_for_precompile(args, kwargs)
         try:
             return self._native_call(self.module.call_data_cache, *args, **kwargs)
         except ValueError as e:
@@ -319,8 +393,18 @@ class FunctionNode(NativeFunctionNode):
         this will generate and compile a new kernel if need be. However the dispatch
         is just added to the command list and no results are returned.
         """
+        self._wait_for_precompile(args, kwargs)
         self._native_append_to(self.module.call_data_cache, command_encoder, *args, **kwargs)
 
+    def append_to_batch(self, batch: "CallBatch", *args: Any, **kwargs: Any) -> int:
+        """
+        Add the function call to a call batch. As with calling, this will generate and
+        compile a new kernel if need be. The call is dispatched when the batch is submitted,
+        and its result is found at the returned index of the list returned by `batch.submit`.
+        """
+        self._wait_for_precompile(args, kwargs)
+        return self._native_append_to_batch(self.module.call_data_cache, batch, *args, **kwargs)
+
     def dispatch(
         self,
         thread_count: uint3,
@@ -461,6 +545,8 @@ class FunctionNodeSet(FunctionNode):
 
 
 class FunctionNodeCUDAStream(FunctionNode):
+    kernel_cacheable = False
+
     def __init__(self, parent: NativeFunctionNode, stream: NativeHandle) -> None:
         if stream.type != NativeHandleType.CUstream:
             raise ValueError("Expected a CUDA stream handle")
@@ -578,6 +664,8 @@ class FunctionNodeThreadGroupSize(FunctionNode):
 
 
 class FunctionNodeLogger(FunctionNode):
+    kernel_cacheable = False
+
     def __init__(self, parent: NativeFunctionNode, logger: Logger) -> None:
         super().__init__(parent, FunctionNodeType.kernelgen, logger)
         self.slangpy_signature = "logger_" + str(id(logger))
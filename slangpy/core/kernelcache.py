@@ -0,0 +1,158 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+import hashlib
+import os
+import struct
+from pathlib import Path
+from typing import TYPE_CHECKING, Any, Optional, Union
+
+from slangpy.core.native import SignatureBuilder
+from slangpy import LMDBCache, SGL_VERSION, SGL_GIT_VERSION, SLANG_BUILD_TAG
+
+if TYPE_CHECKING:
+    from slangpy.core.function import FunctionNode
+    from slangpy.core.module import Module
+
+#: Bump when the format of cached entries changes.
+KERNEL_CACHE_VERSION = 1
+
+_KERNEL_CACHE: Optional["KernelCache"] = None
+
+
+class KernelCacheEntry:
+    """
+    Generated kernel stored in the kernel cache.
+    """
+
+    def __init__(self, hash: str, code: str, module: bytes):
+        super().__init__()
+        #: Hash of the generated code, used as the module name.
+        self.hash = hash
+        #: Generated code.
+        self.code = code
+        #: Serialized Slang module compiled from the generated code.
+        self.module = module
+
+
+class KernelCache:
+    """
+    Persistent on-disk cache of generated kernels, backed by an LMDB database.
+
+    Entries are keyed by the call signature, the contents of all files the called module
+    depends on, the session options and the slangpy/Slang versions. A hit skips code generation
+    and the Slang front-end for the kernel module. Binding arguments and linking the program
+    still run, and compiled target code is cached by the device's shader cache.
+
+    Modules loaded from source strings are not cached, as their contents are not known. Neither
+    are calls through function nodes that refer to live objects, such as loggers or CUDA streams.
+    """
+
+    def __init__(self, path: Union[str, Path], max_size: int = 1024 * 1024 * 1024):
+        super().__init__()
+        self.path = Path(path)
+        self.cache = LMDBCache(self.path, {"max_size": max_size, "background_eviction": True})
+        #: Number of kernels found in the cache.
+        self.hits = 0
+        #: Number of kernels not found in the cache.
+        self.misses = 0
+
+    def key(
+        self, function: "FunctionNode", module: "Module", args: Any, kwargs: Any
+    ) -> Optional[bytes]:
+        """
+        Calculate the cache key for a call, or None if the call can not be cached.
+        """
+        # Signatures of some nodes (e.g. loggers and CUDA streams) are only valid in this process.
+        node: Optional["FunctionNode"] = function
+        while node is not None:
+            if not node.kernel_cacheable:
+                return None
+            node = node.parent
+        digest = module_digest(module)
+        if digest is None:
+            return None
+        builder = SignatureBuilder()
+        function.read_signature(builder)
+        module.call_data_cache.get_args_signature(builder, *args, **kwargs)
+        session = module.device_module.session
+        h = hashlib.sha256()
+        h.update(f"{KERNEL_CACHE_VERSION}\n{SGL_VERSION}\n{SGL_GIT_VERSION}\n".encode())
+        h.update(f"{SLANG_BUILD_TAG}\n".encode())
+        h.update(f"{session.device.info.type}\n{session.uid}\n{digest}\n".encode())
+        h.update(builder.bytes)
+        return h.digest()
+
+    def get(self, key: bytes) -> Optional[KernelCacheEntry]:
+        """
+        Get a cached kernel, or None if not found.
+        """
+        value = self.cache.get(key)
+        if value is None:
+            self.misses += 1
+            return None
+        try:
+            hash_size, code_size = struct.unpack_from("<II", value)
+            offset = struct.calcsize("<II")
+            hash = value[offset : offset + hash_size].decode()
+            offset += hash_size
+            code = value[offset : offset + code_size].decode()
+            offset += code_size
+        except (struct.error, UnicodeDecodeError):
+            # Treat corrupted entries as missing, they are overwritten once rebuilt.
+            self.misses += 1
+            return None
+        self.hits += 1
+        return KernelCacheEntry(hash, code, value[offset:])
+
+    def set(self, key: bytes, entry: KernelCacheEntry):
+        """
+        Store a kernel in the cache.
+        """
+        hash = entry.hash.encode()
+        code = entry.code.encode()
+        self.cache.set(key, struct.pack("<II", len(hash), len(code)) + hash + code + entry.module)
+
+
+def module_digest(module: "Module") -> Optional[str]:
+    """
+    Digest of the contents of all files a module and its linked modules depend on.
+    Computed once per module and reset on hot reload. None if any module was loaded from a string.
+    """
+    if module._kernel_cache_digest is None:
+        module._kernel_cache_digest = _calc_module_digest(module)
+    return module._kernel_cache_digest or None
+
+
+def _calc_module_digest(module: "Module") -> str:
+    device_modules = [module.slangpy_device_module, module.device_module] + module.link
+    if any(str(x.path) == "" for x in device_modules):
+        return ""
+    h = hashlib.sha256()
+    dependencies = sorted(set(str(path) for x in device_modules for path in x.dependencies))
+    try:
+        for path in dependencies:
+            h.update(path.encode())
+            with open(path, "rb") as f:
+                h.update(hashlib.sha256(f.read()).digest())
+    except OSError:
+        return ""
+    return h.hexdigest()
+
+
+def set_kernel_cache_path(path: Optional[Union[str, Path]], max_size: int = 1024 * 1024 * 1024):
+    """
+    Enable the persistent kernel cache at the given path, or disable it if path is None.
+    Can also be enabled via the SLANGPY_KERNEL_CACHE_PATH environment variable.
+    """
+    global _KERNEL_CACHE
+    _KERNEL_CACHE = KernelCache(path, max_size) if path is not None else None
+
+
+def get_kernel_cache() -> Optional[KernelCache]:
+    """
+    Get the persistent kernel cache, or None if disabled.
+    """
+    return _KERNEL_CACHE
+
+
+if os.environ.get("SLANGPY_KERNEL_CACHE_PATH"):
+    set_kernel_cache_path(os.environ["SLANGPY_KERNEL_CACHE_PATH"])
@@ -4,7 +4,7 @@ from typing import TYPE_CHECKING, Any, Optional, Union, Sequence
 from slangpy.core.function import Function
 from slangpy.core.struct import Struct
 
-from slangpy import Pipeline, ShaderTable, SlangModule, Device, Logger
+from slangpy import Pipeline, ShaderTable, SlangModule, Device, Logger, ShaderHotReloadEvent
 from slangpy.core.native import NativeCallDataCache
 from slangpy.reflection import SlangProgramLayout
 from slangpy.bindings.typeregistry import PYTHON_SIGNATURES
@@ -12,6 +12,7 @@ from slangpy.bindings.typeregistry import PYTHON_SIGNATURES
 import weakref
 
 if TYPE_CHECKING:
+    from concurrent.futures import Future
     from slangpy.core.dispatchdata import DispatchData
 
 LOADED_MODULES = weakref.WeakValueDictionary()
@@ -21,7 +22,7 @@ def _check_for_hot_reload(event_info: Any = None):
     global LOADED_MODULES
     for module in LOADED_MODULES.values():
         if module is not None:
-            module.on_hot_reload()
+            module.on_hot_reload(event_info)
 
 
 def _register_hot_reload_hook(device: Device):
@@ -79,6 +80,13 @@ class Module:
 
         self._attr_cache: dict[str, Union[Function, Struct]] = {}
 
+        # Digest of module dependencies for the kernel cache.
+        # Empty if the module can not be cached, None if not computed yet.
+        self._kernel_cache_digest: Optional[str] = None
+
+        # Pending background precompiles, by call signature.
+        self._precompile_futures: dict[bytes, "Future[Any]"] = {}
+
         LOADED_MODULES[self.device_module.name] = self
 
     @staticmethod
@@ -199,10 +207,14 @@ class Module:
             return None
         return child.as_func()
 
-    def on_hot_reload(self):
+    def on_hot_reload(self, event: Optional[ShaderHotReloadEvent] = None):
         """
         Called by device when the module is hot reloaded.
+        Modules in sessions that have not been recreated keep their caches.
         """
+        if event is not None and self.device_module.session not in event.sessions:
+            return
+
         # Relink combined program
         module_list = [self.slangpy_device_module, self.device_module] + self.link
         combined_program = self.device_module.session.link_program(module_list, [])
@@ -214,6 +226,7 @@ class Module:
         self.pipeline_cache = {}
         self.shader_table_cache = {}
         self._attr_cache = {}
+        self._kernel_cache_digest = None
 
     def __getattr__(self, name: str):
         """
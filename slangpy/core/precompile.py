@@ -0,0 +1,49 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
+from typing import Any, Callable, Optional
+
+_EXECUTOR: Optional[ThreadPoolExecutor] = None
+_EXECUTOR_LOCK = threading.Lock()
+_THREAD_STATE = threading.local()
+
+
+def _get_executor() -> ThreadPoolExecutor:
+    global _EXECUTOR
+    with _EXECUTOR_LOCK:
+        if _EXECUTOR is None:
+            # Native compilation, linking and pipeline creation release the GIL and are
+            # serialized per session, so a single worker builds kernels while the caller's
+            # thread keeps running. The session lock is always taken before the GIL.
+            _EXECUTOR = ThreadPoolExecutor(max_workers=1, thread_name_prefix="slangpy-precompile")
+        return _EXECUTOR
+
+
+def _run(func: Callable[[], Any]) -> Any:
+    _THREAD_STATE.precompiling = True
+    try:
+        return func()
+    finally:
+        _THREAD_STATE.precompiling = False
+
+
+def submit_precompile(func: Callable[[], Any]) -> Future[Any]:
+    """
+    Run a precompile task on the background precompile thread.
+    """
+    return _get_executor().submit(_run, func)
+
+
+def is_precompiling() -> bool:
+    """
+    True if called from a precompile task. Pipelines built by precompile tasks compile their
+    target code immediately instead of on first dispatch.
+    """
+    return getattr(_THREAD_STATE, "precompiling", False)
+
+
+def wait_for_precompiles():
+    """
+    Block until all queued precompile tasks have completed.
+    """
+    submit_precompile(lambda: None).result()
@@ -3,7 +3,7 @@
 from pathlib import Path
 from typing import Any, Optional, Sequence
 import pytest
-from slangpy import Bitmap, DataStruct
+from slangpy import Bitmap, BitmapWriter, DataStruct
 import numpy as np
 import numpy.typing as npt
 
@@ -248,5 +248,34 @@ def test_hdr_io(tmp_path: Path, layout: Sequence[Any]):
     write_read_test(tmp_path, "hdr", layout[0], layout[1], layout[2], layout[3], **extra)
 
 
+def test_bitmap_writer(tmp_path: Path):
+    writer = BitmapWriter({"max_pending_bytes": 1024, "overflow_policy": BitmapWriter.OverflowPolicy.block})
+    results = []
+    for i in range(8):
+        bitmap = Bitmap(np.full((16, 16, 4), i, dtype=np.uint8))
+        assert writer.write(bitmap, tmp_path / f"{i}.png", callback=lambda result: results.append(result))
+    writer.write(Bitmap(np.zeros((16, 16, 4), dtype=np.uint8)), tmp_path / "missing" / "error.png")
+    with pytest.raises(RuntimeError):
+        writer.flush()
+    assert writer.pending_count == 0
+    assert writer.failed_count == 1
+    assert len(results) == 8
+    assert all(result.success for result in results)
+    for i in range(8):
+        assert np.all(np.array(Bitmap(tmp_path / f"{i}.png")) == i)
+
+
+def test_bitmap_writer_release_with_pending_callbacks(tmp_path: Path):
+    # Releasing the writer waits for pending writes, whose callbacks need the GIL.
+    writer = BitmapWriter()
+    results = []
+    for i in range(4):
+        bitmap = Bitmap(np.full((1024, 1024, 4), i, dtype=np.uint8))
+        writer.write(bitmap, tmp_path / f"{i}.png", callback=lambda result: results.append(result))
+    del writer
+    assert len(results) == 4
+    assert all(result.success for result in results)
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v", "-s"])
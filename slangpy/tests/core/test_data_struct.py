@@ -331,5 +331,23 @@ def test_blend_gamma():
     check_conversion(s, "@BB", "@B", (100, 200), (ref,))
 
 
+def test_convert_parallel():
+    src = DataStruct()
+    dst = DataStruct()
+    for name in "rgba":
+        src.append(name, DataStruct.Type.uint8, DataStruct.Flags.normalized | DataStruct.Flags.srgb_gamma)
+        dst.append(name, DataStruct.Type.float32)
+
+    data = np.random.default_rng(0).integers(0, 256, size=(100003, 4), dtype=np.uint8).tobytes()
+
+    s = DataStructConverter(src, dst)
+    s.parallel = False
+    serial = s.convert(data)
+
+    s.parallel = True
+    s.min_grain_size = 1000
+    assert s.convert(data) == serial
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v", "-s"])
@@ -116,11 +116,18 @@ def test_hot_reload_event(device_type: spy.DeviceType):
     )
 
     # Setup a hook that increments a counter on hot reload.
+    # Only session ids are kept, so the callback doesn't hold references to the sessions.
+    # The device session is kept alive here, so its Python object (and id) stays the same.
+    session = device.slang_session
     count = 0
+    session_ids = []
+    changed_files = []
 
     def inc_count(x: spy.ShaderHotReloadEvent):
-        nonlocal count
+        nonlocal count, session_ids, changed_files
         count += 1
+        session_ids = [id(s) for s in x.sessions]
+        changed_files = x.changed_files
 
     device.register_shader_hot_reload_callback(inc_count)
 
@@ -130,6 +137,10 @@ def test_hot_reload_event(device_type: spy.DeviceType):
     # Check count.
     assert count == 1
 
+    # Forced reloads recreate all sessions and have no changed files.
+    assert id(session) in session_ids
+    assert len(changed_files) == 0
+
 
 @pytest.mark.parametrize(
     "device_type", [spy.DeviceType.cuda, spy.DeviceType.vulkan, spy.DeviceType.d3d12]
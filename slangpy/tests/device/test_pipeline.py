@@ -144,6 +144,39 @@ def test_compute_set_and_overwrite(device_type: spy.DeviceType):
     ctx.expect_counts([area1 - area2, area2, 0, 0])
 
 
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_compute_pipeline_batch(device_type: spy.DeviceType):
+    ctx = PipelineTestContext(device_type)
+    module = ctx.device.load_module("test_pipeline_utils.slang")
+    programs = module.session.link_programs(
+        [
+            {"modules": [module], "entry_points": [module.entry_point(name)]}
+            for name in ["clear", "count", "setcolor"]
+        ]
+    )
+    assert len(programs) == 3
+    pipelines = ctx.device.create_compute_pipelines([{"program": x} for x in programs])
+    assert len(pipelines) == 3
+    for pipeline in pipelines:
+        assert pipeline.thread_group_size == spy.uint3(16, 16, 1)
+
+    pos = spy.int2(32, 32)
+    size = spy.int2(16, 16)
+    command_encoder = ctx.device.create_command_encoder()
+    with command_encoder.begin_compute_pass() as pass_encoder:
+        shader_object = pass_encoder.bind_pipeline(pipelines[2])
+        cursor = spy.ShaderCursor(shader_object).find_entry_point(0)
+        cursor["render_texture"] = ctx.output_texture
+        cursor["pos"] = pos
+        cursor["size"] = size
+        cursor["color"] = spy.float4(1, 0, 0, 1)
+        pass_encoder.dispatch(thread_count=[ctx.output_texture.width, ctx.output_texture.height, 1])
+    ctx.device.submit_command_buffer(command_encoder.finish())
+
+    area = size.x * size.y
+    ctx.expect_counts([area, 0, 0, area])
+
+
 @pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
 def test_gfx_clear(device_type: spy.DeviceType):
     ctx = PipelineTestContext(device_type)
@@ -0,0 +1,149 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+import numpy as np
+
+import slangpy as spy
+from slangpy.testing import helpers
+
+ADD_FLOATS = r"""
+float add_floats(float a, float b) {
+    return a + b;
+}
+"""
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+@pytest.mark.parametrize("result_type", ["tensor", spy.NDBuffer])
+def test_output_buffers_recycled(device_type: spy.DeviceType, result_type: object):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    device.buffer_pool.clear()
+
+    a = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    b = spy.NDBuffer.from_numpy(device, np.ones(100, dtype=np.float32))
+
+    before = device.buffer_pool_stats
+    for i in range(8):
+        res = func(a, b, _result=result_type)
+        assert np.allclose(res.to_numpy(), np.arange(100) + 1)
+        del res
+        device.wait()
+    after = device.buffer_pool_stats
+
+    # Released storage is reused once the submission that recorded it has finished.
+    assert after.miss_count - before.miss_count == 1
+    assert after.hit_count - before.hit_count == 7
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_released_buffers_wait_for_pending_encoders(device_type: spy.DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    device.buffer_pool.clear()
+
+    a = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    res = func(a, 1.0, _result="tensor")
+
+    # The storage may still be recorded in a command encoder that is not submitted yet.
+    command_encoder = device.create_command_encoder()
+    del res
+    device.wait()
+    before = device.buffer_pool_stats
+    res = func(a, 1.0, _result="tensor")
+    assert device.buffer_pool_stats.miss_count == before.miss_count + 1
+    del res
+
+    device.submit_command_buffer(command_encoder.finish())
+    device.wait()
+    before = device.buffer_pool_stats
+    func(a, 1.0, _result="tensor")
+    assert device.buffer_pool_stats.hit_count == before.hit_count + 1
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_live_outputs_not_reused(device_type: spy.DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    device.buffer_pool.clear()
+
+    a = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    results = [func(a, float(i), _result="tensor") for i in range(4)]
+    device.wait()
+
+    for i, res in enumerate(results):
+        assert np.allclose(res.to_numpy(), np.arange(100) + i)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_max_free_size(device_type: spy.DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    pool = device.buffer_pool
+    pool.clear()
+
+    a = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    b = spy.NDBuffer.from_numpy(device, np.arange(1000, dtype=np.float32))
+    res = func(a, 1.0, _result="tensor")
+    del res
+    # Released buffers are picked up when an allocation finds no free buffer.
+    res = func(b, 1.0, _result="tensor")
+    assert pool.stats.free_count == 1
+
+    pool.max_free_size = 0
+    assert pool.stats.free_count == 0
+    assert pool.stats.free_size == 0
+    pool.max_free_size = 256 * 1024 * 1024
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_reused_buffers_cleared(device_type: spy.DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    device.buffer_pool.clear()
+
+    # Both results fall into the same bucket, the second one doesn't write all of it.
+    a = spy.NDBuffer.from_numpy(device, np.arange(112, dtype=np.float32))
+    res = func(a, 1.0, _result=spy.NDBuffer)
+    del res
+    device.wait()
+
+    b = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    before = device.buffer_pool_stats
+    res = func(b, 1.0, _result=spy.NDBuffer)
+    assert device.buffer_pool_stats.hit_count == before.hit_count + 1
+
+    # Read back only covers the result, the rest of the storage has been cleared.
+    assert np.array_equal(res.to_numpy(), np.arange(100) + 1)
+    storage = res.storage.to_numpy().view(np.float32)
+    assert len(storage) == 112
+    assert np.all(storage[100:] == 0)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_pooling_disabled(device_type: spy.DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_floats", ADD_FLOATS)
+    pool = device.buffer_pool
+    pool.clear()
+
+    a = spy.NDBuffer.from_numpy(device, np.arange(100, dtype=np.float32))
+    pool.enabled = False
+    try:
+        before = pool.stats
+        for i in range(4):
+            res = func(a, float(i), _result="tensor")
+            assert np.allclose(res.to_numpy(), np.arange(100) + i)
+            assert res.storage.size == 400
+            del res
+            device.wait()
+        after = pool.stats
+        assert after.hit_count == before.hit_count
+        assert after.miss_count == before.miss_count
+        assert after.used_count == 0
+    finally:
+        pool.enabled = True
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
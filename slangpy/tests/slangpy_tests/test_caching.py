@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+import numpy as np
 import pytest
 from slangpy import DeviceType
 from slangpy.types.buffer import NDBuffer
@@ -58,5 +59,38 @@ def test_share_compute_pipeline_with_same_mapping(device_type: DeviceType):
     assert float_float_cd.pipeline == mapped_float_float_cd.pipeline
 
 
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_dispatch_after_set_pipeline(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    m = load_test_module(device_type)
+    # Same function in a separate module, so its pipeline has its own layout.
+    other = helpers.create_module(device, BASE_MODULE + "\n// other\n")
+
+    func = m.foo.as_func()
+
+    a_data = np.random.rand(100).astype(np.float32)
+    b_data = np.random.rand(100).astype(np.float32)
+    a = NDBuffer.from_numpy(device, a_data)
+    b = NDBuffer.from_numpy(device, b_data)
+    res = NDBuffer(device, dtype=float, shape=(100,))
+
+    # The second call replays the cursor writes recorded by the first one.
+    for _ in range(2):
+        res.clear()
+        func(a, b, _result=res)
+        assert np.allclose(res.to_numpy(), a_data + b_data)
+
+    # Replacing the pipeline must drop the recorded writes of all arguments,
+    # which refer to the layout of the previous pipeline.
+    call_data = func.debug_build_call_data(a, b, _result=res)
+    other_call_data = other.foo.as_func().debug_build_call_data(a, b, _result=res)
+    assert call_data.pipeline != other_call_data.pipeline
+    call_data.pipeline = other_call_data.pipeline
+
+    res.clear()
+    func(a, b, _result=res)
+    assert np.allclose(res.to_numpy(), a_data + b_data)
+
+
 if __name__ == "__main__":
     pytest.main([__file__, "-v", "-s"])
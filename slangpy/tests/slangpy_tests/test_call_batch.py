@@ -0,0 +1,103 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import pytest
+import numpy as np
+
+from slangpy import DeviceType, CallBatch
+from slangpy.types import NDBuffer
+from slangpy.testing import helpers
+
+
+ADD_NUMBERS = r"""
+int add_numbers(int a, int b) {
+    return a+b;
+}
+"""
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_batch_scalar_results(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    function = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    batch = CallBatch(device)
+    for i in range(10):
+        assert batch.add(function, i, 2 * i) == i
+    assert len(batch) == 10
+
+    results = batch.submit()
+    assert results == [3 * i for i in range(10)]
+
+    # Batch is empty after submit and can be reused.
+    assert len(batch) == 0
+    batch.add(function, 5, 10)
+    assert batch.submit() == [15]
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_batch_mixed_signatures(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    function = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    a = NDBuffer(device, dtype=int, shape=(64,))
+    a.copy_from_numpy(np.arange(64, dtype=np.int32))
+
+    batch = CallBatch(device)
+    batch.add(function, 1, 2)
+    batch.add(function, a, 7)
+    res = NDBuffer(device, dtype=int, shape=(64,))
+    batch.add(function, a, a, _result=res)
+    results = batch.submit()
+
+    assert results[0] == 3
+    assert np.array_equal(results[1].to_numpy(), np.arange(64) + 7)
+    assert np.array_equal(res.to_numpy(), 2 * np.arange(64))
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_batch_clear(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    function = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    batch = CallBatch(device)
+    batch.add(function, 1, 2)
+    batch.clear()
+    assert len(batch) == 0
+    assert batch.submit() == []
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_batch_append_to_batch(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    function = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    batch = CallBatch(device)
+    assert function.append_to_batch(batch, 1, 2) == 0
+    assert function.append_to_batch(batch, 3, 4) == 1
+    assert batch.submit() == [3, 7]
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_batch_dependent_calls(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    function = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    count = 1024 * 1024
+    a = NDBuffer(device, dtype=int, shape=(count,))
+    a.copy_from_numpy(np.arange(count, dtype=np.int32))
+    b = NDBuffer(device, dtype=int, shape=(count,))
+    c = NDBuffer(device, dtype=int, shape=(count,))
+
+    # Each call reads the output of the previous one.
+    batch = CallBatch(device)
+    batch.add(function, a, a, _result=b)
+    batch.add(function, b, a, _result=c)
+    batch.add(function, c, c, _result=b)
+    batch.submit()
+
+    assert np.array_equal(c.to_numpy(), 3 * np.arange(count))
+    assert np.array_equal(b.to_numpy(), 6 * np.arange(count))
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
@@ -0,0 +1,113 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+from pathlib import Path
+from typing import Any
+
+import pytest
+
+from slangpy import DeviceType, Logger, LogLevel, Module, float3, set_kernel_cache_path
+from slangpy.core import calldata
+from slangpy.core.function import FunctionNodeLogger
+from slangpy.core.kernelcache import KernelCache, KernelCacheEntry, get_kernel_cache
+from slangpy.testing import helpers
+
+
+@pytest.fixture
+def kernel_cache(tmp_path: Path):
+    set_kernel_cache_path(tmp_path / "kernel_cache")
+    yield get_kernel_cache()
+    set_kernel_cache_path(None)
+
+
+def test_entry_roundtrip(tmp_path: Path):
+    cache = KernelCache(tmp_path / "kernel_cache")
+    key = b"key"
+    assert cache.get(key) is None
+
+    cache.set(key, KernelCacheEntry("hash", "code", b"\x00\x01\x02"))
+    entry = cache.get(key)
+    assert entry is not None
+    assert entry.hash == "hash"
+    assert entry.code == "code"
+    assert entry.module == b"\x00\x01\x02"
+
+    # Corrupted entries are treated as missing.
+    cache.cache.set(key, b"\xff")
+    assert cache.get(key) is None
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_kernel_cache_hit(
+    device_type: DeviceType, kernel_cache: KernelCache, monkeypatch: pytest.MonkeyPatch
+):
+    device = helpers.get_device(device_type)
+
+    m = Module(device.load_module("test_modules.slang"))
+    res = m.add_vectors(float3(1, 2, 3), float3(4, 5, 6))
+    assert res == float3(5, 7, 9)
+    assert kernel_cache.cache.stats.entries == 1
+    assert (kernel_cache.hits, kernel_cache.misses) == (0, 1)
+
+    # Code generation must not run once the kernel is cached.
+    def fail_generate_code(*args: Any, **kwargs: Any):
+        raise AssertionError("Kernel was generated instead of loaded from the kernel cache")
+
+    monkeypatch.setattr(calldata, "generate_code", fail_generate_code)
+
+    # A new module has an empty in-memory call data cache, so the kernel is loaded
+    # from the persistent cache.
+    m = Module(device.load_module("test_modules.slang"))
+    res = m.add_vectors(float3(1, 2, 3), float3(4, 5, 6))
+    assert res == float3(5, 7, 9)
+    assert kernel_cache.cache.stats.entries == 1
+    assert (kernel_cache.hits, kernel_cache.misses) == (1, 1)
+
+    # A new device has a new session, so the kernel module is loaded from the serialized module.
+    new_device = helpers.get_device(device_type, use_cache=False)
+    try:
+        m = Module(new_device.load_module("test_modules.slang"))
+        res = m.add_vectors(float3(1, 2, 3), float3(4, 5, 6))
+        assert res == float3(5, 7, 9)
+        assert kernel_cache.cache.stats.entries == 1
+        assert (kernel_cache.hits, kernel_cache.misses) == (2, 1)
+    finally:
+        new_device.close()
+
+    # Different signatures result in different entries.
+    monkeypatch.undo()
+    m = Module(device.load_module("test_modules.slang"))
+    m.add_vectors(float3(1, 2, 3), float3(4, 5, 6), _result="numpy")
+    assert kernel_cache.cache.stats.entries == 2
+    assert (kernel_cache.hits, kernel_cache.misses) == (2, 2)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_kernel_cache_skips_logger_nodes(device_type: DeviceType, kernel_cache: KernelCache):
+    device = helpers.get_device(device_type)
+
+    # The signature of a logger node identifies the logger object, which is only valid
+    # in this process.
+    m = Module(device.load_module("test_modules.slang"))
+    func = FunctionNodeLogger(m.add_vectors, Logger(LogLevel.none))
+    res = func(float3(1, 2, 3), float3(4, 5, 6))
+    assert res == float3(5, 7, 9)
+    assert kernel_cache.cache.stats.entries == 0
+    assert (kernel_cache.hits, kernel_cache.misses) == (0, 0)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_kernel_cache_skips_source_modules(device_type: DeviceType, kernel_cache: KernelCache):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(
+        device,
+        "add",
+        r"""
+float add(float a, float b) { return a + b; }
+""",
+    )
+    assert func(1.0, 2.0) == 3.0
+    assert kernel_cache.cache.stats.entries == 0
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
@@ -0,0 +1,123 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import threading
+from typing import Any
+
+import numpy as np
+import pytest
+
+from slangpy import DeviceType, wait_for_precompiles
+from slangpy.core import calldata
+from slangpy.types.buffer import NDBuffer
+from slangpy.testing import helpers
+
+ADD_NUMBERS = r"""
+float add_numbers(float a, float b) {
+    return a + b;
+}
+"""
+
+MANY_FUNCTIONS = 'import "slangpy";\n' + "\n".join(
+    f"float f{i}(float a, float b) {{ return a * {i} + b; }}" for i in range(16)
+)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_precompile(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    a = NDBuffer(device, dtype=float, shape=(16,))
+    b = NDBuffer(device, dtype=float, shape=(16,))
+    a.copy_from_numpy(np.arange(16, dtype=np.float32))
+    b.copy_from_numpy(np.ones(16, dtype=np.float32))
+
+    assert not func.is_ready(a, b)
+    future = func.precompile(a, b)
+    assert func.precompile(a, b) is future
+    future.result()
+    assert func.is_ready(a, b)
+
+    # Other buffers with the same element type and dimensionality use the precompiled kernel.
+    c = NDBuffer(device, dtype=float, shape=(4,))
+    c.copy_from_numpy(np.ones(4, dtype=np.float32))
+    assert func.is_ready(c, c)
+    assert not func.is_ready(1.0, 2.0)
+
+    res = func(a, b, _result="numpy")
+    assert np.allclose(res, np.arange(16, dtype=np.float32) + 1)
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_call_waits_for_precompile(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    func = helpers.create_function_from_module(device, "add_numbers", ADD_NUMBERS)
+
+    a = NDBuffer(device, dtype=float, shape=(16,))
+    a.copy_from_numpy(np.ones(16, dtype=np.float32))
+    futures = [func.precompile(1.0, 2.0), func.precompile(a, a, _result="numpy")]
+
+    # Calls wait for pending precompiles instead of building the kernels again.
+    assert func(1.0, 2.0) == 3.0
+    assert futures[0].done()
+    res = func(a, a, _result="numpy")
+    assert np.allclose(res, 2)
+    assert futures[1].done()
+
+    wait_for_precompiles()
+    assert func.module.call_data_cache.size == 2
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_calls_during_precompile(device_type: DeviceType, monkeypatch: pytest.MonkeyPatch):
+    device = helpers.get_device(device_type)
+    module = helpers.create_module(device, MANY_FUNCTIONS)
+
+    # Hold the precompile worker in the middle of building a kernel.
+    worker_started = threading.Event()
+    release_worker = threading.Event()
+    generate_code = calldata.generate_code
+
+    def gated_generate_code(*args: Any, **kwargs: Any):
+        if threading.current_thread() is not threading.main_thread():
+            worker_started.set()
+            assert release_worker.wait(timeout=60)
+        return generate_code(*args, **kwargs)
+
+    monkeypatch.setattr(calldata, "generate_code", gated_generate_code)
+
+    future = module.f0.precompile(1.0, 2.0)
+    assert worker_started.wait(timeout=60)
+
+    # Kernels of other functions in the same session are built and dispatched meanwhile.
+    for i in range(1, 4):
+        assert getattr(module, f"f{i}")(1.0, 2.0) == i + 2.0
+    assert not future.done()
+
+    release_worker.set()
+    future.result(timeout=60)
+    assert module.f0(1.0, 2.0) == 2.0
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_calls_while_precompiling(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+    module = helpers.create_module(device, MANY_FUNCTIONS)
+
+    a = NDBuffer(device, dtype=float, shape=(16,))
+    a.copy_from_numpy(np.ones(16, dtype=np.float32))
+
+    # Build and dispatch new kernels on this thread while the worker builds kernels in the same
+    # session. Both threads take the session lock and the GIL, which must not deadlock.
+    futures = [getattr(module, f"f{i}").precompile(a, a, _result="numpy") for i in range(8)]
+    for i in range(8, 16):
+        assert getattr(module, f"f{i}")(1.0, 2.0) == i + 2.0
+    for future in futures:
+        future.result(timeout=60)
+    for i in range(8):
+        res = getattr(module, f"f{i}")(a, a, _result="numpy")
+        assert np.allclose(res, i + 1)
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v"])
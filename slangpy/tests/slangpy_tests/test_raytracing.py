@@ -96,6 +96,84 @@ def build_tlas(
     return tlas
 
 
+def instance_desc(instance_id: int) -> spy.AccelerationStructureInstanceDesc:
+    return spy.AccelerationStructureInstanceDesc(
+        {
+            "transform": spy.float3x4.identity(),
+            "instance_id": instance_id,
+            "instance_mask": 0xFF,
+        }
+    )
+
+
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_instance_list_incremental_upload(device_type: DeviceType):
+    device = helpers.get_device(device_type)
+
+    if not device.has_feature(spy.Feature.acceleration_structure):
+        pytest.skip("Acceleration structures not supported on this device")
+
+    ids = list(range(1000))
+    instance_list = device.create_acceleration_structure_instance_list(len(ids))
+    for i in ids:
+        instance_list.write(i, instance_desc(i))
+    buffer = instance_list.buffer()
+    old_data = buffer.to_numpy().copy()
+
+    # buffer() may be referenced by command encoders that are not submitted yet,
+    # so writes after it was returned are uploaded to another buffer while there are any.
+    pending_encoder = device.create_command_encoder()
+    for i in [3, 4, 500, 999]:
+        ids[i] = 10000 + i
+        instance_list.write(i, instance_desc(ids[i]))
+    new_buffer = instance_list.buffer()
+    assert new_buffer is not buffer
+    assert np.array_equal(buffer.to_numpy(), old_data)
+    device.submit_command_buffer(pending_encoder.finish())
+    device.wait()
+    first_buffer, buffer = buffer, new_buffer
+
+    # Without pending command encoders and work on the GPU, the buffer is updated in place.
+    ids[1] = 30000
+    instance_list.write(1, instance_desc(ids[1]))
+    assert instance_list.buffer() is buffer
+    device.wait()
+
+    # The previous buffer is reused once the work that may use it has finished.
+    pending_encoder = device.create_command_encoder()
+    ids[2] = 40000
+    instance_list.write(2, instance_desc(ids[2]))
+    assert instance_list.buffer() is first_buffer
+    device.submit_command_buffer(pending_encoder.finish())
+    device.wait()
+    buffer = first_buffer
+
+    # update() records the upload to the existing buffer on the given command encoder.
+    command_encoder = device.create_command_encoder()
+    ids[0] = 20000
+    instance_list.write(0, instance_desc(ids[0]))
+    instance_list.update(command_encoder)
+    device.submit_command_buffer(command_encoder.finish())
+    assert instance_list.buffer() is buffer
+
+    # Growing past the capacity reallocates the buffer.
+    instance_list.resize(2000)
+    for i in range(1000, 2000):
+        ids.append(i)
+        instance_list.write(i, instance_desc(i))
+    assert instance_list.buffer() is not buffer
+
+    # Compare against a list uploaded in one go.
+    reference_list = device.create_acceleration_structure_instance_list(len(ids))
+    for i, instance_id in enumerate(ids):
+        reference_list.write(i, instance_desc(instance_id))
+
+    size = len(ids) * instance_list.instance_stride
+    data = instance_list.buffer().to_numpy().view(np.uint8)[:size]
+    reference_data = reference_list.buffer().to_numpy().view(np.uint8)[:size]
+    assert np.array_equal(data, reference_data)
+
+
 @pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
 def test_raytracing(device_type: DeviceType):
     device = helpers.get_device(device_type)
@@ -0,0 +1,96 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+import gc
+from typing import Any
+import pytest
+
+from slangpy.core.native import NativeCallDataCache, SignatureBuilder
+
+
+def signature(cache: NativeCallDataCache, value: Any) -> str:
+    builder = SignatureBuilder()
+    cache.get_value_signature(builder, value)
+    return builder.str
+
+
+class Plain:
+    pass
+
+
+class WithThis:
+    def __init__(self, this: Any):
+        super().__init__()
+        self.this = this
+
+    def get_this(self) -> Any:
+        return self.this
+
+
+class Slotted:
+    __slots__ = ("x",)
+
+
+def test_basic_types_repeat():
+    cache = NativeCallDataCache()
+    for _ in range(3):
+        assert signature(cache, 1) == "int\n"
+        assert signature(cache, 1.0) == "float\n"
+        assert signature(cache, True) == "int\n"
+        assert signature(cache, "a") == "string\n"
+        assert signature(cache, (1, 2.0)) == "tuple\nint\nfloat\n"
+        assert signature(cache, [1]) == "list\nint\n"
+        assert signature(cache, {"a": 1}) == "dict\n\na:int\n"
+
+
+def test_instance_signature_attribute():
+    cache = NativeCallDataCache()
+
+    # Instances of one type may or may not carry a signature in their __dict__.
+    a = Plain()
+    b = Plain()
+    b.slangpy_signature = "[sig]"  # type: ignore
+    assert signature(cache, a) == "Plain\n\n"
+    assert signature(cache, b) == "Plain\n[sig]\n"
+    assert signature(cache, a) == "Plain\n\n"
+
+    c = Slotted()
+    assert signature(cache, c) == "Slotted\n\n"
+
+
+def test_get_this():
+    cache = NativeCallDataCache()
+    assert signature(cache, WithThis(1)) == "WithThis\nint\n"
+    assert signature(cache, WithThis([2.0])) == "WithThis\nlist\nfloat\n"
+
+
+def test_type_modified_after_classification():
+    class Mutable:
+        pass
+
+    cache = NativeCallDataCache()
+    assert signature(cache, Mutable()) == "Mutable\n\n"
+
+    # Adding a class attribute must be picked up by later signatures.
+    Mutable.slangpy_signature = "[mutated]"  # type: ignore
+    assert signature(cache, Mutable()) == "Mutable\n[mutated]\n"
+
+
+def test_runtime_types():
+    cache = NativeCallDataCache()
+
+    # Types created and freed at runtime must not be confused with new types at the same address,
+    # and must not grow the cache forever.
+    for i in range(3000):
+        if i % 2 == 0:
+            value = type(f"T{i}", (tuple,), {})((1,))
+            assert signature(cache, value) == "tuple\nint\n"
+        else:
+            value = type(f"T{i}", (), {})()
+            assert signature(cache, value) == f"T{i}\n\n"
+        del value
+        if i % 100 == 0:
+            gc.collect()
+
+
+if __name__ == "__main__":
+    pytest.main([__file__, "-v", "-s"])
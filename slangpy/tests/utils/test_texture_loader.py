@@ -292,6 +292,20 @@ def test_load_textures(device_type: spy.DeviceType):
     assert len(textures) == 2
 
 
+@pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
+def test_load_textures_bounded_memory(device_type: spy.DeviceType):
+    device = helpers.get_device(type=device_type)
+
+    # With a tiny memory limit, images are loaded and uploaded one at a time.
+    loader = TextureLoader(device)
+    paths = [TEST_IMAGE_DIR / f for f in TEST_BITMAP_FILES] * 4
+    textures = loader.load_textures(paths, options={"max_in_flight_bytes": 1})
+    assert len(textures) == len(paths)
+    for path, texture in zip(paths, textures):
+        bitmap_ref = Bitmap(path).convert(pixel_format=Bitmap.PixelFormat.rgba)
+        assert np.all(np.array(texture.to_bitmap(), copy=False) == np.array(bitmap_ref, copy=False))
+
+
 @pytest.mark.parametrize("device_type", helpers.DEFAULT_DEVICE_TYPES)
 def test_load_texture_array(device_type: spy.DeviceType):
     device = helpers.get_device(type=device_type)
@@ -48,6 +48,7 @@ derivative works thereof, in binary and source code form.
 
 #include "sgl/core/config.h"
 #include "sgl/core/macros.h"
+#include "sgl/core/bitmap_writer.h"
 #include "sgl/core/error.h"
 #include "sgl/core/logger.h"
 #include "sgl/core/file_stream.h"
@@ -93,6 +94,7 @@ SGL_DIAGNOSTIC_POP
 #include <ImfMatrixAttribute.h>
 #include <ImfVersion.h>
 #include <ImfIO.h>
+#include <ImfThreading.h>
 #include <ImathBox.h>
 #include <IlmThreadPool.h>
 #else
@@ -106,13 +108,46 @@ SGL_DIAGNOSTIC_POP
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <thread>
 
 SGL_DISABLE_MSVC_WARNING(4611)
 
 namespace sgl {
 
+/// Bitmaps smaller than this (in bytes) are processed on the calling thread.
+static constexpr size_t PARALLEL_MIN_SIZE = 1024 * 1024;
+/// Approximate number of bytes processed per parallel task.
+static constexpr size_t PARALLEL_BAND_SIZE = 256 * 1024;
+
+/// Number of threads used for EXR I/O.
+static std::atomic<uint32_t> s_exr_thread_count{std::thread::hardware_concurrency()};
+/// Set on threads that should decode and convert EXR images serially (i.e. tasks of \c Bitmap::read_multiple).
+static thread_local bool t_exr_serial = false;
+
+/// Writer shared by \c Bitmap::write_async, created on first use and released in \c Bitmap::static_shutdown.
+static std::mutex s_async_writer_mutex;
+static ref<BitmapWriter> s_async_writer;
+
+/// Returns the number of threads to use for EXR I/O on the calling thread (1 means serial).
+static uint32_t exr_threads()
+{
+    return t_exr_serial ? 1 : std::max(s_exr_thread_count.load(), 1u);
+}
+
+/// Scope in which EXR images are decoded and converted serially on the calling thread.
+struct SerialEXRScope {
+    bool prev;
+    SerialEXRScope()
+        : prev(t_exr_serial)
+    {
+        t_exr_serial = true;
+    }
+    ~SerialEXRScope() { t_exr_serial = prev; }
+};
+
 Bitmap::Bitmap(
     PixelFormat pixel_format,
     ComponentType component_type,
@@ -193,11 +228,14 @@ Bitmap::~Bitmap()
 std::vector<ref<Bitmap>> Bitmap::read_multiple(std::span<std::filesystem::path> paths, FileFormat format)
 {
     std::vector<ref<Bitmap>> bitmaps(paths.size());
+    // Files are already read in parallel, so each file is decoded and converted serially
+    // instead of spawning nested parallel work from the pool threads.
     thread::parallel_for(
         thread::blocked_range<size_t>(0, paths.size()),
         [&](const thread::blocked_range<size_t>& range)
         {
             size_t i = range.begin();
+            SerialEXRScope scope;
             bitmaps[i] = make_ref<Bitmap>(paths[i], format);
         }
     );
@@ -275,13 +313,23 @@ void Bitmap::write(const std::filesystem::path& path, FileFormat format, int qua
 
 void Bitmap::write_async(const std::filesystem::path& path, FileFormat format, int quality) const
 {
-    // Increment reference count to ensure that the bitmap is not destroyed before written.
-    this->inc_ref();
-    thread::global_task_group().do_async(
-        [=, this]()
+    // Writes share a bounded queue to avoid piling up an unbounded amount of pending bitmaps.
+    ref<BitmapWriter> writer;
+    {
+        std::lock_guard lock(s_async_writer_mutex);
+        if (!s_async_writer)
+            s_async_writer = make_ref<BitmapWriter>();
+        writer = s_async_writer;
+    }
+    writer->write(
+        this,
+        path,
+        format,
+        quality,
+        [](const BitmapWriter::WriteResult& result)
         {
-            this->write(path, format, quality);
-            this->dec_ref();
+            if (!result.success)
+                log_error("Failed to write bitmap \"{}\": {}", result.path, result.error);
         }
     );
 }
@@ -315,21 +363,41 @@ void Bitmap::clear()
     std::memset(m_data.get(), 0, buffer_size());
 }
 
-void Bitmap::vflip()
+void Bitmap::vflip(bool parallel)
 {
+    if (m_height < 2)
+        return;
+
     size_t row_size = buffer_size() / m_height;
     size_t half_height = m_height / 2;
-    uint8_t* temp = reinterpret_cast<uint8_t*>(alloca(row_size));
     uint8_t* data = uint8_data();
-    for (size_t i = 0, j = m_height - 1; i < half_height; ++i) {
-        std::memcpy(temp, data + i * row_size, row_size);
-        std::memcpy(data + i * row_size, data + j * row_size, row_size);
-        std::memcpy(data + j * row_size, temp, row_size);
-        j--;
+
+    auto flip_rows = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) {
+            uint8_t* top = data + i * row_size;
+            uint8_t* bottom = data + (m_height - 1 - i) * row_size;
+            std::swap_ranges(top, top + row_size, bottom);
+        }
+    };
+
+    // Small bitmaps are flipped serially, large ones in bands of rows.
+    if (!parallel || buffer_size() < PARALLEL_MIN_SIZE) {
+        flip_rows(0, half_height);
+        return;
     }
+
+    size_t rows_per_band = std::max(size_t(1), PARALLEL_BAND_SIZE / row_size);
+    thread::parallel_for(
+        thread::blocked_range<size_t>(0, half_height, rows_per_band),
+        [&](const thread::blocked_range<size_t>& range)
+        {
+            flip_rows(range.begin(), range.end());
+        }
+    );
 }
 
-std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
+std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split(bool parallel) const
 {
     if (m_pixel_format != PixelFormat::multi_channel)
         return {{"", ref(const_cast<Bitmap*>(this))}};
@@ -403,6 +471,7 @@ std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
         }
 
         DataStructConverter converter(m_pixel_struct, target_struct);
+        converter.set_parallel(parallel);
         converter.convert(data(), target->data(), pixel_count());
 
         result.push_back({prefix, target});
@@ -412,7 +481,8 @@ std::vector<std::pair<std::string, ref<Bitmap>>> Bitmap::split() const
     return result;
 }
 
-ref<Bitmap> Bitmap::convert(PixelFormat pixel_format, ComponentType component_type, bool srgb_gamma) const
+ref<Bitmap>
+Bitmap::convert(PixelFormat pixel_format, ComponentType component_type, bool srgb_gamma, bool parallel) const
 {
     uint32_t channel_count = 0;
     std::vector<std::string> channel_names;
@@ -423,11 +493,11 @@ ref<Bitmap> Bitmap::convert(PixelFormat pixel_format, ComponentType component_ty
     ref<Bitmap> result
         = make_ref<Bitmap>(pixel_format, component_type, m_width, m_height, channel_count, channel_names);
     result->set_srgb_gamma(srgb_gamma);
-    convert(result);
+    convert(result, parallel);
     return result;
 }
 
-void Bitmap::convert(Bitmap* target) const
+void Bitmap::convert(Bitmap* target, bool parallel) const
 {
     if (width() != target->width() || height() != target->height())
         SGL_THROW(
@@ -484,6 +554,7 @@ void Bitmap::convert(Bitmap* target) const
     }
 
     ref<DataStructConverter> converter = make_ref<DataStructConverter>(src_struct, dst_struct);
+    converter->set_parallel(parallel);
     converter->convert(data(), target->data(), pixel_count());
 }
 
@@ -559,12 +630,30 @@ Bitmap::FileFormat Bitmap::detect_file_format(Stream* stream)
     return format;
 }
 
+void Bitmap::set_exr_thread_count(uint32_t count)
+{
+    s_exr_thread_count = count;
+#if SGL_HAS_OPENEXR
+    Imf::setGlobalThreadCount(count > 1 ? int(count) : 0);
+#endif
+}
+
+uint32_t Bitmap::exr_thread_count()
+{
+    return s_exr_thread_count;
+}
+
 void Bitmap::static_init()
 {
-    // IlmThread::ThreadPool::globalThreadPool().setThreadProvider(new EXRThreadPool());
+    set_exr_thread_count(s_exr_thread_count);
 }
 
-void Bitmap::static_shutdown() { }
+void Bitmap::static_shutdown()
+{
+    // Releasing the writer waits for pending writes, which needs the task pool to still be running.
+    std::lock_guard lock(s_async_writer_mutex);
+    s_async_writer.reset();
+}
 
 void Bitmap::rebuild_pixel_struct(uint32_t channel_count, const std::vector<std::string>& channel_names)
 {
@@ -1490,8 +1579,11 @@ private:
 
 void Bitmap::read_exr(Stream* stream)
 {
+    // Chunks are decompressed on the OpenEXR thread pool (see set_exr_thread_count).
+    // The file is still read sequentially from the stream.
+    uint32_t thread_count = exr_threads();
     EXRIStream is(stream);
-    Imf::InputFile file(is);
+    Imf::InputFile file(is, thread_count > 1 ? int(thread_count) : 0);
 
     const Imf::Header& header = file.header();
     const Imf::ChannelList& channels = header.channels();
@@ -2047,8 +2139,10 @@ void Bitmap::write_exr(Stream* stream, int quality) const
         framebuffer.insert(channel_name, slice);
     }
 
+    // Chunks are compressed on the OpenEXR thread pool (see set_exr_thread_count).
+    uint32_t thread_count = exr_threads();
     EXROStream os(stream);
-    Imf::OutputFile file(os, header);
+    Imf::OutputFile file(os, header, thread_count > 1 ? int(thread_count) : 0);
     file.setFrameBuffer(framebuffer);
     file.writePixels(static_cast<int>(m_height));
 }
@@ -2188,6 +2282,7 @@ void Bitmap::read_exr(Stream* stream)
         m_component_type
     );
 
+    // tinyexr decompresses the whole image serially. Only the channel interleave below is parallel.
     EXRImage image;
     InitEXRImage(&image);
 
@@ -2225,25 +2320,40 @@ void Bitmap::read_exr(Stream* stream)
     m_data = std::unique_ptr<uint8_t[]>(new uint8_t[row_stride * m_height]);
     m_owns_data = true;
 
-    for (const auto& field : *m_pixel_struct) {
-        int channel_index = find_channel_index(field.name);
-        const uint8_t* src = image.images[channel_index];
-        uint8_t* dst = uint8_data() + field.offset;
-        if (component_size == 2) {
-            for (size_t j = 0; j < m_width * m_height; ++j) {
-                std::memcpy(dst, src, 2);
-                src += 2;
-                dst += pixel_stride;
-            }
-        } else if (component_size == 4) {
-            for (size_t j = 0; j < m_width * m_height; ++j) {
-                std::memcpy(dst, src, 4);
-                src += 4;
+    if (component_size != 2 && component_size != 4)
+        SGL_THROW("Unsupported component size!");
+
+    std::vector<const uint8_t*> planes;
+    for (const auto& field : *m_pixel_struct)
+        planes.push_back(image.images[find_channel_index(field.name)]);
+
+    // Convert planar to interleaved format.
+    auto interleave_rows = [&](size_t begin, size_t end)
+    {
+        for (size_t i = 0; i < planes.size(); ++i) {
+            const uint8_t* src = planes[i] + begin * m_width * component_size;
+            uint8_t* dst = uint8_data() + begin * row_stride + (*m_pixel_struct)[i].offset;
+            for (size_t j = 0; j < (end - begin) * m_width; ++j) {
+                if (component_size == 2)
+                    std::memcpy(dst, src, 2);
+                else
+                    std::memcpy(dst, src, 4);
+                src += component_size;
                 dst += pixel_stride;
             }
-        } else {
-            SGL_THROW("Unsupported component size!");
         }
+    };
+
+    if (exr_threads() <= 1 || buffer_size() < PARALLEL_MIN_SIZE) {
+        interleave_rows(0, m_height);
+    } else {
+        thread::parallel_for(
+            thread::blocked_range<size_t>(0, m_height, std::max(size_t(1), PARALLEL_BAND_SIZE / row_stride)),
+            [&](const thread::blocked_range<size_t>& range)
+            {
+                interleave_rows(range.begin(), range.end());
+            }
+        );
     }
 
     FreeEXRImage(&image);
@@ -2301,28 +2411,42 @@ void Bitmap::write_exr(Stream* stream, int quality) const
     size_t row_stride = pixel_stride * m_width;
     size_t plane_size = row_stride * m_height;
 
+    if (component_size != 2 && component_size != 4)
+        SGL_THROW("Unsupported component size!");
+
     std::vector<std::unique_ptr<uint8_t[]>> images(channel_count());
     std::vector<uint8_t*> image_ptrs(channel_count());
     for (size_t i = 0; i < channel_count(); ++i) {
         images[i] = std::unique_ptr<uint8_t[]>(new uint8_t[plane_size]);
         image_ptrs[i] = images[i].get();
-        const uint8_t* src = uint8_data() + i * component_size;
-        uint8_t* dst = images[i].get();
-        if (component_size == 2) {
-            for (size_t j = 0; j < m_width * m_height; ++j) {
-                std::memcpy(dst, src, 2);
-                src += pixel_stride;
-                dst += 2;
-            }
-        } else if (component_size == 4) {
-            for (size_t j = 0; j < m_width * m_height; ++j) {
-                std::memcpy(dst, src, 4);
+    }
+
+    auto deinterleave_rows = [&](size_t begin, size_t end)
+    {
+        for (size_t i = 0; i < channel_count(); ++i) {
+            const uint8_t* src = uint8_data() + begin * row_stride + i * component_size;
+            uint8_t* dst = image_ptrs[i] + begin * m_width * component_size;
+            for (size_t j = 0; j < (end - begin) * m_width; ++j) {
+                if (component_size == 2)
+                    std::memcpy(dst, src, 2);
+                else
+                    std::memcpy(dst, src, 4);
                 src += pixel_stride;
-                dst += 4;
+                dst += component_size;
             }
-        } else {
-            SGL_THROW("Unsupported component size!");
         }
+    };
+
+    if (exr_threads() <= 1 || buffer_size() < PARALLEL_MIN_SIZE) {
+        deinterleave_rows(0, m_height);
+    } else {
+        thread::parallel_for(
+            thread::blocked_range<size_t>(0, m_height, std::max(size_t(1), PARALLEL_BAND_SIZE / row_stride)),
+            [&](const thread::blocked_range<size_t>& range)
+            {
+                deinterleave_rows(range.begin(), range.end());
+            }
+        );
     }
 
     image.width = m_width;
@@ -148,12 +148,15 @@ public:
     ~Bitmap();
 
     /// Load a list of bitmaps from multiple paths. Uses multi-threading to load bitmaps in parallel.
+    /// Each bitmap is decoded and converted on a single thread.
     static std::vector<ref<Bitmap>>
     read_multiple(std::span<std::filesystem::path> paths, FileFormat format = FileFormat::auto_);
 
     void write(Stream* stream, FileFormat format = FileFormat::auto_, int quality = -1) const;
     void write(const std::filesystem::path& path, FileFormat format = FileFormat::auto_, int quality = -1) const;
 
+    /// Write the bitmap asynchronously using a shared \c BitmapWriter with default options.
+    /// Blocks if too many bitmaps are pending to be written. Use \c BitmapWriter for more control.
     void write_async(const std::filesystem::path& path, FileFormat format = FileFormat::auto_, int quality = -1) const;
 
     /// The pixel format.
@@ -222,7 +225,8 @@ public:
     void clear();
 
     /// Vertically flip the bitmap.
-    void vflip();
+    /// Large bitmaps are flipped in parallel (in bands of rows) unless \c parallel is false.
+    void vflip(bool parallel = true);
 
     /**
      * \brief Split bitmap into multiple bitmaps, each containing the channels with the same prefix.
@@ -235,13 +239,19 @@ public:
      *
      * Any channels that do not have a prefix will be returned in the bitmap with the empty prefix.
      *
+     * \param parallel Split large bitmaps in parallel.
      * \return Returns a list of (prefix, bitmap) pairs.
      */
-    std::vector<std::pair<std::string, ref<Bitmap>>> split() const;
+    std::vector<std::pair<std::string, ref<Bitmap>>> split(bool parallel = true) const;
 
-    ref<Bitmap> convert(PixelFormat pixel_format, ComponentType component_type, bool srgb_gamma) const;
+    /// Convert the bitmap to a new bitmap with the given format.
+    /// Large bitmaps are converted in parallel unless \c parallel is false.
+    ref<Bitmap>
+    convert(PixelFormat pixel_format, ComponentType component_type, bool srgb_gamma, bool parallel = true) const;
 
-    void convert(Bitmap* target) const;
+    /// Convert the bitmap into the format of the target bitmap.
+    /// Large bitmaps are converted in parallel unless \c parallel is false.
+    void convert(Bitmap* target, bool parallel = true) const;
 
     /// Equality operator.
     bool operator==(const Bitmap& other) const;
@@ -253,6 +263,15 @@ public:
 
     static FileFormat detect_file_format(Stream* stream);
 
+    /// Set the number of threads used to decode and encode EXR images.
+    /// With OpenEXR this sizes the OpenEXR thread pool that (de)compresses chunks.
+    /// With tinyexr, decompression is serial and only the channel interleave runs on the task pool.
+    /// A value of 0 or 1 disables multi-threading. Defaults to the number of hardware threads.
+    static void set_exr_thread_count(uint32_t count);
+
+    /// The number of threads used to decode and encode EXR images.
+    static uint32_t exr_thread_count();
+
     static void static_init();
     static void static_shutdown();
 
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "bitmap_writer.h"
+
+#include "sgl/core/error.h"
+#include "sgl/core/logger.h"
+#include "sgl/core/string.h"
+#include "sgl/core/thread.h"
+
+#include <utility>
+
+namespace sgl {
+
+BitmapWriter::BitmapWriter(std::optional<Options> options)
+    : m_options(options.value_or(Options{}))
+{
+}
+
+BitmapWriter::~BitmapWriter()
+{
+    // The writer may be released from Python, while pending writes need the GIL to invoke Python callbacks.
+    PyGILRelease gil;
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(
+        lock,
+        [this]
+        {
+            return m_pending_count == 0;
+        }
+    );
+}
+
+bool BitmapWriter::write(
+    const Bitmap* bitmap,
+    const std::filesystem::path& path,
+    Bitmap::FileFormat format,
+    int quality,
+    CompletionCallback callback
+)
+{
+    SGL_CHECK_NOT_NULL(bitmap);
+
+    size_t size = bitmap->buffer_size();
+    {
+        std::unique_lock lock(m_mutex);
+        auto has_room = [&]
+        {
+            return m_pending_count == 0 || m_pending_bytes + size <= m_options.max_pending_bytes;
+        };
+        if (!has_room()) {
+            if (m_options.overflow_policy == OverflowPolicy::drop) {
+                m_dropped_count++;
+                return false;
+            }
+            m_cv.wait(lock, has_room);
+        }
+        m_pending_count++;
+        m_pending_bytes += size;
+    }
+
+    thread::global_task_group().do_async(
+        [this, bitmap = ref<const Bitmap>(bitmap), path, format, quality, callback = std::move(callback), size]()
+        {
+            WriteResult result{.path = path, .success = true};
+            try {
+                bitmap->write(path, format, quality);
+            } catch (const std::exception& e) {
+                result.success = false;
+                result.error = e.what();
+            }
+            if (callback) {
+                try {
+                    callback(result);
+                } catch (const std::exception& e) {
+                    log_error("Exception in bitmap writer completion callback: {}", e.what());
+                }
+            }
+            complete(result, size);
+        }
+    );
+
+    return true;
+}
+
+void BitmapWriter::complete(const WriteResult& result, size_t size)
+{
+    // Notify while holding the lock, the writer may be destroyed as soon as the lock is released.
+    std::lock_guard lock(m_mutex);
+    if (!result.success) {
+        m_failed_count++;
+        if (m_unflushed_failed_count++ == 0)
+            m_first_error = result;
+    }
+    m_pending_count--;
+    m_pending_bytes -= size;
+    m_cv.notify_all();
+}
+
+void BitmapWriter::flush()
+{
+    size_t failed_count;
+    WriteResult first_error;
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(
+            lock,
+            [this]
+            {
+                return m_pending_count == 0;
+            }
+        );
+        failed_count = std::exchange(m_unflushed_failed_count, 0);
+        first_error = std::move(m_first_error);
+    }
+    if (failed_count > 0) {
+        SGL_THROW(
+            "Failed to write {} bitmap(s), first error at \"{}\": {}",
+            failed_count,
+            first_error.path,
+            first_error.error
+        );
+    }
+}
+
+size_t BitmapWriter::pending_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pending_count;
+}
+
+size_t BitmapWriter::pending_bytes() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_pending_bytes;
+}
+
+size_t BitmapWriter::dropped_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_dropped_count;
+}
+
+size_t BitmapWriter::failed_count() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_failed_count;
+}
+
+std::string BitmapWriter::to_string() const
+{
+    std::lock_guard lock(m_mutex);
+    return fmt::format(
+        "BitmapWriter(\n"
+        "  max_pending_bytes = {},\n"
+        "  overflow_policy = {},\n"
+        "  pending_count = {},\n"
+        "  pending_bytes = {}\n"
+        ")",
+        string::format_byte_size(m_options.max_pending_bytes),
+        m_options.overflow_policy,
+        m_pending_count,
+        string::format_byte_size(m_pending_bytes)
+    );
+}
+
+} // namespace sgl
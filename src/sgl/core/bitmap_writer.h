@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include "sgl/core/macros.h"
+#include "sgl/core/object.h"
+#include "sgl/core/enum.h"
+#include "sgl/core/bitmap.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace sgl {
+
+/// Writes bitmaps to disk asynchronously on the global task pool.
+/// Pending writes are bounded by the total size of the queued bitmaps. Once the bound is reached,
+/// new writes either block until enough pending writes have completed or are dropped.
+class SGL_API BitmapWriter : public Object {
+    SGL_OBJECT(BitmapWriter)
+public:
+    enum class OverflowPolicy {
+        /// Block the caller until there is room in the queue.
+        block,
+        /// Drop the write.
+        drop,
+    };
+
+    SGL_ENUM_INFO(
+        OverflowPolicy,
+        {
+            {OverflowPolicy::block, "block"},
+            {OverflowPolicy::drop, "drop"},
+        }
+    );
+
+    struct Options {
+        /// Maximum total size (in bytes) of bitmaps pending to be written.
+        /// A single bitmap larger than this is still accepted if no other writes are pending.
+        size_t max_pending_bytes{512ull * 1024 * 1024};
+        /// Behavior when the queue is full.
+        OverflowPolicy overflow_policy{OverflowPolicy::block};
+    };
+
+    /// Result of a single write.
+    struct WriteResult {
+        /// Destination path.
+        std::filesystem::path path;
+        /// True if the bitmap was written successfully.
+        bool success{false};
+        /// Error message if the write failed.
+        std::string error;
+    };
+
+    /// Callback invoked on the worker thread once a write has completed (successfully or not).
+    using CompletionCallback = std::function<void(const WriteResult& result)>;
+
+    BitmapWriter(std::optional<Options> options = {});
+
+    /// Destructor. Waits for all pending writes (with the GIL released).
+    ~BitmapWriter();
+
+    const Options& options() const { return m_options; }
+
+    /**
+     * \brief Queue a bitmap to be written.
+     *
+     * The bitmap is kept alive until it is written and must not be modified in the meantime.
+     *
+     * \param bitmap Bitmap to write.
+     * \param path File path.
+     * \param format File format.
+     * \param quality Quality for lossy formats.
+     * \param callback Optional callback invoked when the write has completed.
+     * \return True if the write was queued, false if it was dropped.
+     */
+    bool write(
+        const Bitmap* bitmap,
+        const std::filesystem::path& path,
+        Bitmap::FileFormat format = Bitmap::FileFormat::auto_,
+        int quality = -1,
+        CompletionCallback callback = {}
+    );
+
+    /// Block until all writes queued by this writer have completed.
+    /// Throws if any of the writes completed since the last flush have failed.
+    void flush();
+
+    /// Number of writes that are queued or in progress.
+    size_t pending_count() const;
+
+    /// Total size (in bytes) of bitmaps that are queued or in progress.
+    size_t pending_bytes() const;
+
+    /// Number of writes dropped because the queue was full.
+    size_t dropped_count() const;
+
+    /// Number of writes that have failed.
+    size_t failed_count() const;
+
+    std::string to_string() const override;
+
+private:
+    void complete(const WriteResult& result, size_t size);
+
+    Options m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_pending_count{0};
+    size_t m_pending_bytes{0};
+    size_t m_dropped_count{0};
+    size_t m_failed_count{0};
+    /// Failed writes since the last flush.
+    size_t m_unflushed_failed_count{0};
+    WriteResult m_first_error;
+};
+
+SGL_ENUM_REGISTER(BitmapWriter::OverflowPolicy);
+
+} // namespace sgl
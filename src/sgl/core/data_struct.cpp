@@ -51,6 +51,7 @@ derivative works thereof, in binary and source code form.
 #include "sgl/core/maths.h"
 #include "sgl/core/string.h"
 #include "sgl/core/hash.h"
+#include "sgl/core/thread.h"
 
 #include "sgl/math/float16.h"
 #include "sgl/math/colorspace.h"
@@ -66,6 +67,8 @@ derivative works thereof, in binary and source code form.
 #endif
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <unordered_map>
 #include <map>
@@ -653,11 +656,13 @@ std::vector<Op> generate_code(const DataStruct& src_struct, const DataStruct& ds
 
 
 /// Interface for conversion programs.
-struct Program {
-    virtual ~Program() = default;
+struct DataStructProgram {
+    virtual ~DataStructProgram() = default;
     virtual void execute(const void* src, void* dst, size_t count) const = 0;
 };
 
+using Program = DataStructProgram;
+
 /// Conversion program for the virtual machine.
 struct VMProgram : public Program {
     std::vector<Op> code;
@@ -687,6 +692,482 @@ struct VMProgram : public Program {
     }
 };
 
+/// Conversion program interpreted on blocks of structs.
+/// Values are processed in single precision, with one lane per struct. Each op is dispatched once per block
+/// instead of once per struct, and chains of ops on 8-bit values are replaced by lookup tables.
+/// This supports the common image formats (8/16-bit integer, half and single precision fields).
+struct BlockProgram : public Program {
+    static constexpr size_t LANES = 16;
+    static constexpr size_t REGISTER_COUNT = 8;
+
+    using Lane = float[LANES];
+
+    struct LaneOp {
+        enum class Type : uint8_t {
+            copy,
+            load,
+            load_lut,
+            load_imm,
+            save,
+            linear_to_srgb,
+            srgb_to_linear,
+            multiply,
+            divide,
+            multiply_add,
+            round,
+            clamp,
+            quantize,
+        };
+        Type type;
+        uint8_t reg;
+        uint8_t src_reg{0};
+        bool to_srgb{false};
+        DataStruct::Type data_type{DataStruct::Type::float32};
+        size_t offset{0};
+        size_t dst_offset{0};
+        size_t size{0};
+        float a{0.f};
+        float b{0.f};
+        double scale{1.0};
+        const float* lut{nullptr};
+    };
+
+    std::vector<LaneOp> ops;
+    std::vector<std::vector<float>> luts;
+    size_t src_size;
+    size_t dst_size;
+
+    void execute(const void* src, void* dst, size_t count) const override
+    {
+        const uint8_t* src_ptr = static_cast<const uint8_t*>(src);
+        uint8_t* dst_ptr = static_cast<uint8_t*>(dst);
+
+        alignas(64) Lane regs[REGISTER_COUNT] = {};
+
+        for (size_t i = 0; i < count; i += LANES) {
+            size_t n = std::min(LANES, count - i);
+            for (const LaneOp& op : ops)
+                run(op, regs, src_ptr, dst_ptr, n);
+            src_ptr += LANES * src_size;
+            dst_ptr += LANES * dst_size;
+        }
+    }
+
+    void run(const LaneOp& op, Lane* regs, const uint8_t* src, uint8_t* dst, size_t n) const
+    {
+        float* r = regs[op.reg];
+
+        switch (op.type) {
+        case LaneOp::Type::copy:
+            src += op.offset;
+            dst += op.dst_offset;
+            switch (op.size) {
+            case 1:
+                for (size_t i = 0; i < n; ++i)
+                    dst[i * dst_size] = src[i * src_size];
+                break;
+            case 2:
+                for (size_t i = 0; i < n; ++i)
+                    store(dst + i * dst_size, load<uint16_t>(src + i * src_size));
+                break;
+            case 4:
+                for (size_t i = 0; i < n; ++i)
+                    store(dst + i * dst_size, load<uint32_t>(src + i * src_size));
+                break;
+            default:
+                SGL_UNREACHABLE();
+            }
+            break;
+        case LaneOp::Type::load:
+            src += op.offset;
+            switch (op.data_type) {
+            case DataStruct::Type::uint8:
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = src[i * src_size];
+                break;
+            case DataStruct::Type::uint16:
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = load<uint16_t>(src + i * src_size);
+                break;
+            case DataStruct::Type::float16:
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = math::float16_to_float32(load<uint16_t>(src + i * src_size));
+                break;
+            case DataStruct::Type::float32:
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = load<float>(src + i * src_size);
+                break;
+            default:
+                SGL_UNREACHABLE();
+            }
+            break;
+        case LaneOp::Type::load_lut:
+            src += op.offset;
+            if (op.data_type == DataStruct::Type::uint8) {
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = op.lut[src[i * src_size]];
+            } else {
+                for (size_t i = 0; i < n; ++i)
+                    r[i] = op.lut[load<uint16_t>(src + i * src_size)];
+            }
+            break;
+        case LaneOp::Type::load_imm:
+            for (size_t i = 0; i < LANES; ++i)
+                r[i] = op.a;
+            break;
+        case LaneOp::Type::save:
+            dst += op.offset;
+            switch (op.data_type) {
+            case DataStruct::Type::uint8:
+                for (size_t i = 0; i < n; ++i)
+                    dst[i * dst_size] = static_cast<uint8_t>(static_cast<int32_t>(r[i]));
+                break;
+            case DataStruct::Type::uint16:
+                for (size_t i = 0; i < n; ++i)
+                    store(dst + i * dst_size, static_cast<uint16_t>(static_cast<int32_t>(r[i])));
+                break;
+            case DataStruct::Type::float16:
+                for (size_t i = 0; i < n; ++i)
+                    store(dst + i * dst_size, math::float32_to_float16(r[i]));
+                break;
+            case DataStruct::Type::float32:
+                for (size_t i = 0; i < n; ++i)
+                    store(dst + i * dst_size, r[i]);
+                break;
+            default:
+                SGL_UNREACHABLE();
+            }
+            break;
+        case LaneOp::Type::linear_to_srgb:
+            gamma(r, to_srgb_coeffs, true);
+            break;
+        case LaneOp::Type::srgb_to_linear:
+            gamma(r, from_srgb_coeffs, false);
+            break;
+        case LaneOp::Type::multiply:
+            for (size_t i = 0; i < LANES; ++i)
+                r[i] *= op.a;
+            break;
+        case LaneOp::Type::divide:
+            for (size_t i = 0; i < LANES; ++i)
+                r[i] /= op.a;
+            break;
+        case LaneOp::Type::multiply_add: {
+            const float* s = regs[op.src_reg];
+            for (size_t i = 0; i < LANES; ++i)
+                r[i] += s[i] * op.a;
+            break;
+        }
+        case LaneOp::Type::round:
+            // Round to nearest even by adding and subtracting 2^23, which vectorizes without SSE4.1.
+            // Values with a magnitude of 2^23 or more are already integral.
+            for (size_t i = 0; i < LANES; ++i) {
+                float magic = std::copysign(8388608.f, r[i]);
+                float rounded = (r[i] + magic) - magic;
+                r[i] = std::abs(r[i]) < 8388608.f ? rounded : r[i];
+            }
+            break;
+        case LaneOp::Type::clamp:
+            for (size_t i = 0; i < LANES; ++i)
+                r[i] = std::min(std::max(r[i], op.a), op.b);
+            break;
+        case LaneOp::Type::quantize: {
+            // Values are rounded to integers in double precision, which makes rounding match the other backends.
+            alignas(64) double v[LANES];
+            for (size_t i = 0; i < LANES; ++i)
+                v[i] = r[i];
+            if (op.to_srgb)
+                gamma(v, to_srgb_coeffs, true);
+            for (size_t i = 0; i < LANES; ++i) {
+                double scaled = v[i] * op.scale;
+                double magic = std::copysign(4503599627370496.0, scaled);
+                double rounded = std::abs(scaled) < 4503599627370496.0 ? (scaled + magic) - magic : scaled;
+                r[i] = static_cast<float>(std::min(std::max(rounded, double(op.a)), double(op.b)));
+            }
+            break;
+        }
+        }
+    }
+
+    template<typename T>
+    static T load(const uint8_t* ptr)
+    {
+        T value;
+        std::memcpy(&value, ptr, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static void store(uint8_t* ptr, T value)
+    {
+        std::memcpy(ptr, &value, sizeof(T));
+    }
+
+    // Rational polynomial fit, rel.err = 8*10^-15
+    static constexpr double to_srgb_coeffs[2][11] = {
+        {
+            -0.0031151377052754843,
+            0.5838023820686707,
+            8.450947414259522,
+            27.901125077137042,
+            32.44669922192121,
+            15.374469584296442,
+            3.0477578489880823,
+            0.2263810267005674,
+            0.002531335520959116,
+            -0.00021805827098915798,
+            -3.7113872202050023e-6,
+        },
+        {
+            1.,
+            10.723011300050162,
+            29.70548706952188,
+            30.50364355650628,
+            13.297981743005433,
+            2.575446652731678,
+            0.21749170309546628,
+            0.007244514696840552,
+            0.00007045228641004039,
+            -8.387527630781522e-9,
+            2.2380622409188757e-11,
+        },
+    };
+
+    // Rational polynomial fit, rel.err = 1.5*10^-15
+    static constexpr double from_srgb_coeffs[2][10] = {
+        {
+            -342.62884098034357,
+            -3483.4445569178347,
+            -9735.250875334352,
+            -10782.158977031822,
+            -5548.704065887224,
+            -1446.951694673217,
+            -200.19589605282445,
+            -14.786385491859248,
+            -0.5489744177844188,
+            -0.008042950896814532,
+        },
+        {
+            1.,
+            -84.8098437770271,
+            -1884.7738197074218,
+            -8059.219012060384,
+            -11916.470977597566,
+            -7349.477378676199,
+            -2013.8039726540235,
+            -237.47722999429413,
+            -9.646075249097724,
+            -2.2132610916769585e-8,
+        },
+    };
+
+    /// Forward/inverse gamma correction using the sRGB profile.
+    /// Uses the same rational polynomial fits as the JIT compiled programs, evaluated in double precision.
+    template<typename T, size_t N>
+    static void gamma(T* x, const double (&coeffs)[2][N], bool to_srgb)
+    {
+        const double threshold = to_srgb ? 0.0031308 : 0.04045;
+        const double scale = to_srgb ? 12.92 : (1.0 / 12.92);
+
+        for (size_t i = 0; i < LANES; ++i) {
+            double v = x[i];
+            double y = to_srgb ? std::sqrt(std::max(v, 0.0)) : v;
+            double a = coeffs[0][0];
+            double b = coeffs[1][0];
+            for (size_t j = 1; j < N; ++j) {
+                a = a * y + coeffs[0][j];
+                b = b * y + coeffs[1][j];
+            }
+            x[i] = static_cast<T>((v < threshold ? scale : a / b) * v);
+        }
+    }
+
+    static bool is_supported(DataStruct::Type type)
+    {
+        return type == DataStruct::Type::uint8 || type == DataStruct::Type::uint16
+            || type == DataStruct::Type::float16 || type == DataStruct::Type::float32;
+    }
+
+    /// Returns the value of a virtual machine register as a float.
+    static float to_float(const VM::Value& value)
+    {
+        if (DataStruct::is_integer(value.type))
+            return DataStruct::is_unsigned(value.type) ? static_cast<float>(value.u) : static_cast<float>(value.i);
+        return value.type == DataStruct::Type::float64 ? static_cast<float>(value.d) : value.s;
+    }
+
+    /// Returns true if an op only operates on its own register.
+    static bool is_unary(const Op& op)
+    {
+        return op.type == Op::Type::cast || op.type == Op::Type::linear_to_srgb
+            || op.type == Op::Type::srgb_to_linear || op.type == Op::Type::multiply || op.type == Op::Type::round
+            || op.type == Op::Type::clamp;
+    }
+
+    /// Compile a conversion program.
+    /// Returns nullptr if the conversion is not supported in single precision.
+    static std::unique_ptr<Program> compile(const DataStruct& src_struct, const DataStruct& dst_struct)
+    {
+        std::vector<Op> code = generate_code(src_struct, dst_struct);
+
+        auto program = std::make_unique<BlockProgram>();
+        program->src_size = src_struct.size();
+        program->dst_size = dst_struct.size();
+
+        for (size_t i = 0; i < code.size(); ++i) {
+            const Op& op = code[i];
+            if (op.reg >= REGISTER_COUNT)
+                return nullptr;
+
+            // Find the end of the chain of unary ops following this op.
+            size_t end = i + 1;
+            while (end < code.size() && code[end].reg == op.reg && is_unary(code[end]))
+                ++end;
+
+            // Fuse gamma correction, de-normalization, rounding and clamping of integer destination values.
+            size_t j = i;
+            LaneOp quantize{.type = LaneOp::Type::quantize, .reg = op.reg};
+            if (code[j].type == Op::Type::linear_to_srgb) {
+                quantize.to_srgb = true;
+                j++;
+            }
+            if (j < end && code[j].type == Op::Type::multiply)
+                quantize.scale = code[j++].multiply.value;
+            if (j + 1 < end && code[j].type == Op::Type::round && code[j + 1].type == Op::Type::clamp) {
+                quantize.a = static_cast<float>(code[j + 1].clamp.min);
+                quantize.b = static_cast<float>(code[j + 1].clamp.max);
+                program->ops.push_back(quantize);
+                i = j + 1;
+                continue;
+            }
+
+            switch (op.type) {
+            case Op::Type::load_mem: {
+                DataStruct::Type type = op.load_mem.type;
+                if (op.load_mem.swap || !is_supported(type))
+                    return nullptr;
+
+                // Copy fields that are not converted.
+                const Op& next = code[std::min(i + 1, code.size() - 1)];
+                if (next.type == Op::Type::save_mem && next.reg == op.reg && !next.save_mem.swap) {
+                    program->ops.push_back({
+                        .type = LaneOp::Type::copy,
+                        .reg = op.reg,
+                        .offset = op.load_mem.offset,
+                        .dst_offset = next.save_mem.offset,
+                        .size = DataStruct::type_size(type),
+                    });
+                    i++;
+                    break;
+                }
+
+                // Precompute the chain of ops for all 8-bit values, and for 16-bit values if the chain involves
+                // gamma correction. Running the chain in the virtual machine makes the result exact.
+                bool has_gamma = false;
+                for (size_t j = i + 1; j < end; ++j)
+                    has_gamma |= code[j].type == Op::Type::linear_to_srgb || code[j].type == Op::Type::srgb_to_linear;
+                if (end > i + 1
+                    && (type == DataStruct::Type::uint8 || (type == DataStruct::Type::uint16 && has_gamma))) {
+                    std::vector<Op> chain(code.begin() + i, code.begin() + end);
+                    chain[0].load_mem.offset = 0;
+                    size_t lut_size = type == DataStruct::Type::uint8 ? 256 : 65536;
+                    std::vector<float>& lut = program->luts.emplace_back(lut_size);
+                    VM vm;
+                    for (size_t value = 0; value < lut.size(); ++value) {
+                        uint8_t data[2];
+                        if (type == DataStruct::Type::uint8)
+                            data[0] = static_cast<uint8_t>(value);
+                        else
+                            store(data, static_cast<uint16_t>(value));
+                        vm.src = data;
+                        vm.run(chain);
+                        lut[value] = to_float(vm.registers[op.reg]);
+                    }
+                    program->ops.push_back({
+                        .type = LaneOp::Type::load_lut,
+                        .reg = op.reg,
+                        .data_type = type,
+                        .offset = op.load_mem.offset,
+                        .lut = lut.data(),
+                    });
+                    i = end - 1;
+                    break;
+                }
+
+                program->ops.push_back(
+                    {.type = LaneOp::Type::load, .reg = op.reg, .data_type = type, .offset = op.load_mem.offset}
+                );
+                break;
+            }
+            case Op::Type::load_imm: {
+                // Fold constant.
+                VM vm;
+                vm.run(std::span(code.begin() + i, code.begin() + end));
+                program->ops.push_back(
+                    {.type = LaneOp::Type::load_imm, .reg = op.reg, .a = to_float(vm.registers[op.reg])}
+                );
+                i = end - 1;
+                break;
+            }
+            case Op::Type::save_mem:
+                if (op.save_mem.swap || !is_supported(op.save_mem.type))
+                    return nullptr;
+                program->ops.push_back({
+                    .type = LaneOp::Type::save,
+                    .reg = op.reg,
+                    .data_type = op.save_mem.type,
+                    .offset = op.save_mem.offset,
+                });
+                break;
+            case Op::Type::cast:
+                // All values are kept in single precision, conversion happens when saving.
+                break;
+            case Op::Type::linear_to_srgb:
+                program->ops.push_back({.type = LaneOp::Type::linear_to_srgb, .reg = op.reg});
+                break;
+            case Op::Type::srgb_to_linear:
+                program->ops.push_back({.type = LaneOp::Type::srgb_to_linear, .reg = op.reg});
+                break;
+            case Op::Type::multiply: {
+                // Normalization multiplies by the reciprocal of the type range, divide instead to avoid
+                // rounding the reciprocal to single precision.
+                double divisor = 1.0 / op.multiply.value;
+                if (divisor > 1.0 && divisor == std::rint(divisor))
+                    program->ops.push_back(
+                        {.type = LaneOp::Type::divide, .reg = op.reg, .a = static_cast<float>(divisor)}
+                    );
+                else
+                    program->ops.push_back(
+                        {.type = LaneOp::Type::multiply, .reg = op.reg, .a = static_cast<float>(op.multiply.value)}
+                    );
+                break;
+            }
+            case Op::Type::multiply_add:
+                program->ops.push_back({
+                    .type = LaneOp::Type::multiply_add,
+                    .reg = op.reg,
+                    .src_reg = op.multiply_add.reg,
+                    .a = static_cast<float>(op.multiply_add.factor),
+                });
+                break;
+            case Op::Type::round:
+                program->ops.push_back({.type = LaneOp::Type::round, .reg = op.reg});
+                break;
+            case Op::Type::clamp:
+                program->ops.push_back({
+                    .type = LaneOp::Type::clamp,
+                    .reg = op.reg,
+                    .a = static_cast<float>(op.clamp.min),
+                    .b = static_cast<float>(op.clamp.max),
+                });
+                break;
+            }
+        }
+
+        return program;
+    }
+};
+
 #if SGL_HAS_ASMJIT
 
 /// Conversion program running just-in-time compiled X86 code.
@@ -1995,18 +2476,58 @@ private:
 #endif // SGL_HAS_ASMJIT
 
 
+/// Global cache of compiled conversion programs.
+/// Programs are never released, so pointers to them stay valid for the lifetime of the process.
+/// Lookups are lock-free: the lookup table is immutable and replaced by a new copy whenever a program is added.
+/// Only compiling a new program takes a lock. Replaced tables are freed once no lookup is in progress.
 class ProgramCache {
 public:
-    const Program* get_program(const DataStruct& src_struct, const DataStruct& dst_struct)
+    using Backend = DataStructConverter::Backend;
+
+    const Program* get_program(const DataStruct& src_struct, const DataStruct& dst_struct, Backend backend)
     {
+        size_t key = hash(hash(src_struct), hash(dst_struct), backend);
+
+        // Readers announce themselves before loading the table, see retire_tables().
+        m_readers.fetch_add(1);
+        const Program* found = find(m_table.load(), key, src_struct, dst_struct, backend);
+        m_readers.fetch_sub(1);
+        if (found)
+            return found;
+
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto key = std::make_pair(src_struct, dst_struct);
-        auto it = m_programs.find(key);
-        if (it != m_programs.end())
-            return it->second.get();
-        auto [it2, inserted] = m_programs.emplace(key, compile_program(src_struct, dst_struct));
-        return it2->second.get();
+        // Check again, another thread might have compiled the program in the meantime.
+        const Table* table = m_table.load();
+        if (const Program* program = find(table, key, src_struct, dst_struct, backend))
+            return program;
+
+        auto entry = std::make_unique<Entry>(Entry{
+            .key = key,
+            .backend = backend,
+            .src_struct = src_struct,
+            .dst_struct = dst_struct,
+            .program = compile_program(src_struct, dst_struct, backend),
+        });
+
+        // Publish a new table including the new entry.
+        auto new_table = std::make_unique<Table>(table ? *table : Table{});
+        auto it = std::lower_bound(
+            new_table->begin(),
+            new_table->end(),
+            key,
+            [](const Entry* e, size_t value) { return e->key < value; }
+        );
+        new_table->insert(it, entry.get());
+        m_table.store(new_table.get());
+
+        if (m_current_table)
+            m_retired_tables.push_back(std::move(m_current_table));
+        m_current_table = std::move(new_table);
+        retire_tables();
+
+        m_entries.push_back(std::move(entry));
+        return m_entries.back()->program.get();
     }
 
     static ProgramCache& get()
@@ -2016,16 +2537,66 @@ public:
     }
 
 private:
-    std::unique_ptr<Program> compile_program(const DataStruct& src_struct, const DataStruct& dst_struct)
+    struct Entry {
+        size_t key;
+        Backend backend;
+        DataStruct src_struct;
+        DataStruct dst_struct;
+        std::unique_ptr<Program> program;
+    };
+
+    /// Entries sorted by key.
+    using Table = std::vector<const Entry*>;
+
+    static const Program* find(
+        const Table* table,
+        size_t key,
+        const DataStruct& src_struct,
+        const DataStruct& dst_struct,
+        Backend backend
+    )
+    {
+        if (!table)
+            return nullptr;
+        auto it = std::lower_bound(
+            table->begin(),
+            table->end(),
+            key,
+            [](const Entry* e, size_t value) { return e->key < value; }
+        );
+        for (; it != table->end() && (*it)->key == key; ++it) {
+            const Entry* e = *it;
+            if (e->backend == backend && e->src_struct == src_struct && e->dst_struct == dst_struct)
+                return e->program.get();
+        }
+        return nullptr;
+    }
+
+    /// Free replaced tables if no lookup is in progress.
+    /// A reader increments \c m_readers before loading \c m_table (all sequentially consistent). If the count is
+    /// observed to be zero after a new table was stored, any later reader is guaranteed to load the new table.
+    void retire_tables()
+    {
+        if (!m_retired_tables.empty() && m_readers.load() == 0)
+            m_retired_tables.clear();
+    }
+
+    std::unique_ptr<Program>
+    compile_program(const DataStruct& src_struct, const DataStruct& dst_struct, Backend backend)
     {
         std::unique_ptr<Program> program;
 
+        if (backend == Backend::block)
+            program = BlockProgram::compile(src_struct, dst_struct);
+
 #if SGL_HAS_ASMJIT
+        if (!program && (backend == Backend::automatic || backend == Backend::jit)) {
 #if SGL_X86_64
-        program = X86Program::compile(src_struct, dst_struct);
+            program = X86Program::compile(src_struct, dst_struct);
 #elif SGL_ARM64
-        program = ARMProgram::compile(src_struct, dst_struct);
+            program = ARMProgram::compile(src_struct, dst_struct);
 #endif
+        }
 #endif // SGL_HAS_ASMJIT
         if (!program)
             program = VMProgram::compile(src_struct, dst_struct);
@@ -2033,33 +2604,61 @@ private:
         return program;
     }
 
+    std::atomic<const Table*> m_table{nullptr};
+    /// Number of lookups in progress.
+    std::atomic<uint32_t> m_readers{0};
     std::mutex m_mutex;
-    std::unordered_map<
-        std::pair<DataStruct, DataStruct>,
-        std::unique_ptr<Program>,
-        hasher<std::pair<DataStruct, DataStruct>>,
-        comparator<std::pair<DataStruct, DataStruct>>>
-        m_programs;
+    std::unique_ptr<Table> m_current_table;
+    /// Replaced tables that may still be used by lookups in progress.
+    std::vector<std::unique_ptr<Table>> m_retired_tables;
+    std::vector<std::unique_ptr<Entry>> m_entries;
 };
 
 
-DataStructConverter::DataStructConverter(const DataStruct* src, const DataStruct* dst)
+DataStructConverter::DataStructConverter(const DataStruct* src, const DataStruct* dst, Backend backend)
     : m_src(new DataStruct(*src))
     , m_dst(new DataStruct(*dst))
+    , m_backend(backend)
 {
+    if (*m_src != *m_dst) {
+        m_program = ProgramCache::get().get_program(*m_src, *m_dst, m_backend);
+        SGL_CHECK(m_program, "Failed to compile conversion program.");
+    }
 }
 
 void DataStructConverter::convert(const void* src, void* dst, size_t count) const
 {
     // Direct copy if source and destination struct are the same.
-    if (*m_src == *m_dst) {
+    if (!m_program) {
         std::memcpy(dst, src, m_src->size() * count);
         return;
     }
 
-    const Program* program = ProgramCache::get().get_program(*m_src, *m_dst);
-    SGL_CHECK(program, "Failed to compile conversion program.");
-    program->execute(src, dst, count);
+    const Program* program = m_program;
+
+    // Split large conversions into chunks that fit into cache.
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+    size_t grain_size = std::max(m_min_grain_size, CHUNK_SIZE / (m_src->size() + m_dst->size()));
+    grain_size = std::max(align_to(size_t(64), grain_size), size_t(64));
+
+    if (!m_parallel || count <= grain_size) {
+        program->execute(src, dst, count);
+        return;
+    }
+
+    thread::parallel_for(
+        thread::blocked_range<size_t>(0, count, grain_size),
+        [&](const thread::blocked_range<size_t>& range)
+        {
+            size_t begin = range.begin();
+            size_t end = range.end();
+            program->execute(
+                static_cast<const uint8_t*>(src) + begin * m_src->size(),
+                static_cast<uint8_t*>(dst) + begin * m_dst->size(),
+                end - begin
+            );
+        }
+    );
 }
 
 std::string DataStructConverter::to_string() const
@@ -325,6 +325,8 @@ SGL_ENUM_REGISTER(DataStruct::Flags);
 SGL_ENUM_CLASS_OPERATORS(DataStruct::Flags);
 SGL_ENUM_REGISTER(DataStruct::ByteOrder);
 
+struct DataStructProgram;
+
 /**
  * \brief Data struct converter.
  *
@@ -333,10 +335,35 @@ SGL_ENUM_REGISTER(DataStruct::ByteOrder);
 class SGL_API DataStructConverter : Object {
     SGL_OBJECT(DataStructConverter)
 public:
+    /// Backend used for running conversion programs.
+    enum class Backend {
+        /// Use \c jit if available, \c vm otherwise.
+        automatic,
+        /// Interpret the conversion program, one struct at a time.
+        vm,
+        /// Run just-in-time compiled code, one struct at a time (falls back to \c vm if not available).
+        jit,
+        /// Interpret the conversion program on blocks of structs in single precision
+        /// (falls back to \c vm if not supported). Only used if requested explicitly.
+        block,
+    };
+
+    SGL_ENUM_INFO(
+        Backend,
+        {
+            {Backend::automatic, "automatic"},
+            {Backend::vm, "vm"},
+            {Backend::jit, "jit"},
+            {Backend::block, "block"},
+        }
+    );
+
     /// Constructor.
+    /// The conversion program is compiled (or looked up in the global program cache) on construction.
     /// \param src Source struct definition.
     /// \param dst Destination struct definition.
-    DataStructConverter(const DataStruct* src, const DataStruct* dst);
+    /// \param backend Backend used for running the conversion.
+    DataStructConverter(const DataStruct* src, const DataStruct* dst, Backend backend = Backend::automatic);
 
     /// The source struct definition.
     const DataStruct* src() const { return m_src; }
@@ -344,6 +371,19 @@ public:
     /// The destination struct definition.
     const DataStruct* dst() const { return m_dst; }
 
+    /// The backend used for running the conversion.
+    Backend backend() const { return m_backend; }
+
+    /// Minimum number of structs converted per task when converting in parallel.
+    /// Large conversions are split into chunks that fit into cache, but no smaller than this.
+    size_t min_grain_size() const { return m_min_grain_size; }
+    void set_min_grain_size(size_t min_grain_size) { m_min_grain_size = min_grain_size; }
+
+    /// Convert large ranges in parallel using the global thread pool.
+    /// Callers that already run conversions in parallel should disable this.
+    bool parallel() const { return m_parallel; }
+    void set_parallel(bool parallel) { m_parallel = parallel; }
+
     /// Convert data from source struct to destination struct.
     /// \param src Source data.
     /// \param dst Destination data.
@@ -355,6 +395,13 @@ public:
 private:
     ref<const DataStruct> m_src;
     ref<const DataStruct> m_dst;
+    Backend m_backend;
+    /// Conversion program, owned by the global program cache (nullptr if structs are identical).
+    const DataStructProgram* m_program{nullptr};
+    size_t m_min_grain_size{16384};
+    bool m_parallel{true};
 };
 
+SGL_ENUM_REGISTER(DataStructConverter::Backend);
+
 } // namespace sgl
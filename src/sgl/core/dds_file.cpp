@@ -2,7 +2,7 @@
 
 #include "dds_file.h"
 
-#include "sgl/core/file_stream.h"
+#include "sgl/core/memory_mapped_file.h"
 
 // Adapted from https://github.com/redorav/ddspp
 
@@ -625,24 +625,32 @@ DDSFile::DDSFile(Stream* stream)
     if (m_size < MIN_HEADER_SIZE)
         SGL_THROW("DDS file is too small");
 
-    m_data = new uint8_t[m_size];
-    stream->read(m_data, m_size);
+    m_owned_data = std::make_unique<uint8_t[]>(m_size);
+    stream->read(m_owned_data.get(), m_size);
+    m_data = m_owned_data.get();
 
     if (!decode_header(m_data, m_size))
         SGL_THROW("DDS file has invalid header");
 }
 
 DDSFile::DDSFile(const std::filesystem::path& path)
-    : DDSFile(ref(new FileStream(path, FileStream::Mode::read)))
 {
-}
+    // Map the file instead of reading it, so texture data can be uploaded without an intermediate copy.
+    m_mapped_file = std::make_unique<MemoryMappedFile>(path);
+    if (!m_mapped_file->is_open())
+        SGL_THROW("Failed to open DDS file \"{}\"", path);
 
-DDSFile::~DDSFile()
-{
-    if (m_data)
-        delete[] m_data;
+    m_size = m_mapped_file->size();
+    if (m_size < MIN_HEADER_SIZE)
+        SGL_THROW("DDS file is too small");
+    m_data = static_cast<const uint8_t*>(m_mapped_file->data());
+
+    if (!decode_header(m_data, m_size))
+        SGL_THROW("DDS file has invalid header");
 }
 
+DDSFile::~DDSFile() = default;
+
 const uint8_t* DDSFile::get_subresource_data(uint32_t mip, uint32_t slice) const
 {
     size_t offset = 0;
@@ -7,11 +7,17 @@
 #include "sgl/core/stream.h"
 
 #include <filesystem>
+#include <memory>
 
 namespace sgl {
 
+class MemoryMappedFile;
+
 /**
  * \brief Helper class for loading DDS files.
+ *
+ * When loading from a path, the file is memory mapped and all data accessors
+ * point directly into the mapping. When loading from a stream, the data is read into memory.
  */
 class SGL_API DDSFile : public Object {
     SGL_OBJECT(DDSFile)
@@ -80,9 +86,12 @@ public:
 private:
     bool decode_header(const uint8_t* data, size_t size);
 
-    uint8_t* m_data{nullptr};
+    const uint8_t* m_data{nullptr};
     size_t m_size{0};
 
+    std::unique_ptr<uint8_t[]> m_owned_data;
+    std::unique_ptr<MemoryMappedFile> m_mapped_file;
+
     uint32_t m_dxgi_format;
     TextureType m_type;
     uint32_t m_width;
@@ -4,11 +4,15 @@
 
 #include "sgl/core/error.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 
 #if SGL_LINUX
+#include <sys/eventfd.h>
 #include <sys/inotify.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #endif
 
@@ -19,6 +23,9 @@ struct FileSystemWatchState {
     int watch_descriptor;
 #endif
 #if !SGL_LINUX
+    /// Last write time of the watched directory when \c files was last rebuilt.
+    std::filesystem::file_time_type directory_time;
+    /// Last write times of the files in the watched directory.
     std::map<std::filesystem::path, std::filesystem::file_time_type> files;
 #endif
     FileSystemWatcher* watcher;
@@ -26,6 +33,9 @@ struct FileSystemWatchState {
 };
 
 #if !SGL_LINUX
+/// Interval at which watched directories are scanned for changes.
+static constexpr std::chrono::milliseconds SCAN_INTERVAL{100};
+
 static std::map<std::filesystem::path, std::filesystem::file_time_type>
 get_directory_files(const std::filesystem::path& directory)
 {
@@ -35,12 +45,9 @@ get_directory_files(const std::filesystem::path& directory)
     std::map<std::filesystem::path, std::filesystem::file_time_type> files;
     for (const auto& entry : std::filesystem::directory_iterator(directory)) {
         if (entry.is_regular_file()) {
+            // Directories are not watched recursively, so the file name is the relative path.
+            std::filesystem::path rel_path = entry.path().filename();
             std::error_code ec;
-            std::filesystem::path rel_path = std::filesystem::relative(entry.path(), directory, ec);
-            if (ec) {
-                log_warn("Failed to get relative path for file \"{}\"", entry.path());
-                continue;
-            }
             std::filesystem::file_time_type write_time = std::filesystem::last_write_time(entry.path(), ec);
             if (ec) {
                 log_warn("Failed to get last write time for file \"{}\"", entry.path());
@@ -72,39 +79,51 @@ FileSystemWatcher::FileSystemWatcher()
         close(m_inotify_file_descriptor);
         SGL_THROW("Failed to set inotify file descriptor flags to non-blocking");
     }
+
+    m_stop_file_descriptor = eventfd(0, 0);
+    if (m_stop_file_descriptor < 0) {
+        close(m_inotify_file_descriptor);
+        SGL_THROW("Failed to create event file descriptor");
+    }
 #endif
 
-#if !SGL_LINUX
     m_thread = std::thread(
         [this]()
         {
             thread_func();
         }
     );
-#endif
 }
 
 FileSystemWatcher::~FileSystemWatcher()
 {
-    for (const auto& pair : m_watches) {
-        stop_watch(pair.second);
-    }
 #if SGL_LINUX
-    close(m_inotify_file_descriptor);
+    uint64_t value = 1;
+    if (write(m_stop_file_descriptor, &value, sizeof(value)) < 0)
+        log_error("Failed to signal file system watcher thread to stop");
 #endif
-
 #if !SGL_LINUX
-    m_stop_thread = true;
+    {
+        std::lock_guard<std::mutex> lock(m_watches_mutex);
+        m_stop_thread = true;
+    }
+    m_stop_cv.notify_one();
+#endif
     if (m_thread.joinable())
         m_thread.join();
+
+    for (const auto& pair : m_watches) {
+        stop_watch(pair.second);
+    }
+#if SGL_LINUX
+    close(m_inotify_file_descriptor);
+    close(m_stop_file_descriptor);
 #endif
 }
 
 uint32_t FileSystemWatcher::add_watch(const FileSystemWatchDesc& desc)
 {
-#if !SGL_LINUX
     std::lock_guard<std::mutex> lock(m_watches_mutex);
-#endif
 
     // Check watch doesn't already exist
     for (const auto& pair : m_watches) {
@@ -144,6 +163,8 @@ uint32_t FileSystemWatcher::add_watch(const FileSystemWatchDesc& desc)
 #endif
 
 #if !SGL_LINUX
+    std::error_code ec;
+    state->directory_time = std::filesystem::last_write_time(state->desc.directory, ec);
     state->files = get_directory_files(state->desc.directory);
 #endif
 
@@ -154,9 +175,7 @@ uint32_t FileSystemWatcher::add_watch(const FileSystemWatchDesc& desc)
 void FileSystemWatcher::remove_watch(uint32_t id)
 {
     if (id > 0) {
-#if !SGL_LINUX
         std::lock_guard<std::mutex> lock(m_watches_mutex);
-#endif
         stop_watch(m_watches[id]);
         m_watches.erase(id);
     }
@@ -164,9 +183,7 @@ void FileSystemWatcher::remove_watch(uint32_t id)
 
 void FileSystemWatcher::remove_watch(const std::filesystem::path& directory)
 {
-#if !SGL_LINUX
     std::lock_guard<std::mutex> lock(m_watches_mutex);
-#endif
 
     for (const auto& pair : m_watches) {
         if (pair.second->desc.directory == directory) {
@@ -207,86 +224,132 @@ void FileSystemWatcher::_notify_change(
         .change = change,
         .time = now,
     };
-    {
-#if !SGL_LINUX
-        std::lock_guard<std::mutex> lock(m_queued_events_mutex);
-#endif
-        m_queued_events.push_back(event);
-    }
+    std::lock_guard<std::mutex> lock(m_queued_events_mutex);
+    m_queued_events.push_back(event);
     m_last_event = now;
+    m_has_queued_events.store(true, std::memory_order_release);
 }
 
 void FileSystemWatcher::update()
 {
+    // Events are queued by the background thread, so there is nothing to do unless the flag is set.
+    if (!has_queued_events())
+        return;
+
+    // Report queued events once the disk has been idle for the delay period.
+    std::vector<FileSystemWatchEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(m_queued_events_mutex);
+        auto duration = std::chrono::system_clock::now() - m_last_event;
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+        if (millis <= m_output_delay_ms)
+            return;
+        events = std::move(m_queued_events);
+        m_queued_events.clear();
+        m_has_queued_events.store(false, std::memory_order_release);
+    }
+    if (m_on_change)
+        m_on_change(events);
+}
+
 #if SGL_LINUX
-    // Attempt non-blocking read from inotify, and return if no data.
-    char buffer[4096];
-    int length = read(m_inotify_file_descriptor, buffer, sizeof(buffer));
-    if (length >= 0) {
-        // Iterate over the inotify events and call '_notify_change' on the watcher for each one.
-        int offset = 0;
-        while (offset < length) {
-            auto event = reinterpret_cast<inotify_event*>(buffer + offset);
-            std::filesystem::path path{event->name};
-            FileSystemWatcherChange change = FileSystemWatcherChange::invalid;
-
-            if (event->mask & IN_CREATE) {
-                change = FileSystemWatcherChange::added;
-            } else if (event->mask & IN_DELETE) {
-                change = FileSystemWatcherChange::removed;
-            } else if (event->mask & IN_MODIFY) {
-                change = FileSystemWatcherChange::modified;
-            }
+void FileSystemWatcher::thread_func()
+{
+    // Block until inotify reports events or the watcher is destroyed.
+    // The thread does not wake up at all while nothing changes.
+    pollfd fds[2] = {
+        {.fd = m_inotify_file_descriptor, .events = POLLIN, .revents = 0},
+        {.fd = m_stop_file_descriptor, .events = POLLIN, .revents = 0},
+    };
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            log_error("Failed to poll inotify file descriptor: {}", strerror(errno));
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+            break;
 
-            if (change != FileSystemWatcherChange::invalid) {
-                auto it = std::find_if(
-                    m_watches.begin(),
-                    m_watches.end(),
-                    [event](const auto& pair)
-                    {
-                        return pair.second->watch_descriptor == event->wd;
-                    }
-                );
-                if (it != m_watches.end()) {
-                    _notify_change(it->second.get(), path, change);
+        // Drain all pending events with non-blocking reads from inotify.
+        while (true) {
+            ssize_t length = read(m_inotify_file_descriptor, buffer, sizeof(buffer));
+            if (length <= 0)
+                break;
+
+            // Iterate over the inotify events and call '_notify_change' on the watcher for each one.
+            std::lock_guard<std::mutex> lock(m_watches_mutex);
+            ssize_t offset = 0;
+            while (offset < length) {
+                auto event = reinterpret_cast<inotify_event*>(buffer + offset);
+                std::filesystem::path path{event->name};
+                FileSystemWatcherChange change = FileSystemWatcherChange::invalid;
+
+                if (event->mask & IN_CREATE) {
+                    change = FileSystemWatcherChange::added;
+                } else if (event->mask & IN_DELETE) {
+                    change = FileSystemWatcherChange::removed;
+                } else if (event->mask & IN_MODIFY) {
+                    change = FileSystemWatcherChange::modified;
                 }
-            }
-            offset += sizeof(struct inotify_event) + event->len;
-        }
-    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EBADF) {
-        SGL_THROW("Failed to read from inotify file descriptor");
-    }
-#endif
 
-    // Process queued events.
-    {
-#if !SGL_LINUX
-        std::lock_guard<std::mutex> lock(m_queued_events_mutex);
-#endif
-        if (m_queued_events.size() > 0) {
-            auto duration = std::chrono::system_clock::now() - m_last_event;
-            auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-            if (millis > m_output_delay_ms) {
-                m_on_change(m_queued_events);
-                m_queued_events.clear();
+                if (change != FileSystemWatcherChange::invalid) {
+                    auto it = std::find_if(
+                        m_watches.begin(),
+                        m_watches.end(),
+                        [event](const auto& pair)
+                        {
+                            return pair.second->watch_descriptor == event->wd;
+                        }
+                    );
+                    if (it != m_watches.end()) {
+                        _notify_change(it->second.get(), path, change);
+                    }
+                }
+                offset += sizeof(struct inotify_event) + event->len;
             }
         }
     }
 }
+#endif
 
 #if !SGL_LINUX
 void FileSystemWatcher::thread_func()
 {
-    uint32_t counter = 0;
-    while (!m_stop_thread) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        if (counter++ % 10 != 0)
-            continue;
+    std::unique_lock<std::mutex> lock(m_watches_mutex);
+    while (true) {
+        // Sleep until the next scan, or until the watcher is destroyed.
+        if (m_stop_cv.wait_for(
+                lock,
+                SCAN_INTERVAL,
+                [this]
+                {
+                    return m_stop_thread;
+                }
+            ))
+            break;
 
-        std::lock_guard<std::mutex> lock(m_watches_mutex);
         for (const auto& [_, state] : m_watches) {
-            std::map<std::filesystem::path, std::filesystem::file_time_type> files
-                = get_directory_files(state->desc.directory);
+            const std::filesystem::path& directory = state->desc.directory;
+
+            // Files are only added or removed if the directory's write time changed.
+            // Otherwise only the write times of the known files need to be checked.
+            std::error_code ec;
+            std::filesystem::file_time_type directory_time = std::filesystem::last_write_time(directory, ec);
+            if (!ec && directory_time == state->directory_time) {
+                for (auto& [path, write_time] : state->files) {
+                    std::filesystem::file_time_type time = std::filesystem::last_write_time(directory / path, ec);
+                    if (!ec && time != write_time) {
+                        write_time = time;
+                        _notify_change(state.get(), path, FileSystemWatcherChange::modified);
+                    }
+                }
+                continue;
+            }
+
+            state->directory_time = directory_time;
+            std::map<std::filesystem::path, std::filesystem::file_time_type> files = get_directory_files(directory);
 
             // Detect added and modified files.
             for (const auto& [path, write_time] : files) {
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <map>
@@ -53,8 +54,9 @@ struct FileSystemWatchEvent {
 struct FileSystemWatchState;
 
 /// Monitors directories for changes and calls a callback when they're detected.
-/// The watcher automatically queues up changes until disk has been idle for
-/// a period. Relies on regular polling of update().
+/// Changes are detected on a background thread and queued until disk has been idle for
+/// a period. Queued changes are reported to the callback from update(), which returns
+/// immediately if nothing is queued.
 class SGL_API FileSystemWatcher : public Object {
     SGL_OBJECT(FileSystemWatcher)
 public:
@@ -84,9 +86,13 @@ public:
     /// Set callback for file system events.
     void set_on_change(ChangeCallback on_change);
 
-    /// Update function to poll the watcher + report events.
+    /// Report queued events to the callback once the disk has been idle for the delay period.
     void update();
 
+    /// True if events have been queued by the background thread and not yet reported.
+    /// This is a single atomic load and cheap enough to call on hot paths.
+    bool has_queued_events() const { return m_has_queued_events.load(std::memory_order_acquire); }
+
     /// Delay period before queued events are output.
     uint32_t delay() { return m_output_delay_ms; }
 
@@ -112,29 +118,37 @@ private:
     /// Watch event callback.
     ChangeCallback m_on_change;
 
-    /// Events reported since last call to watch event callback.
+    /// Events reported since last call to watch event callback (protected by m_queued_events_mutex).
     std::vector<FileSystemWatchEvent> m_queued_events;
 
-    /// Time last event was recorded.
+    /// Time last event was recorded (protected by m_queued_events_mutex).
     std::chrono::system_clock::time_point m_last_event;
 
+    /// Set by the background thread when events are queued, cleared once they are reported.
+    std::atomic<bool> m_has_queued_events{false};
+
 #if SGL_LINUX
     /// File descriptor for linux inotify watcher.
     int m_inotify_file_descriptor;
+
+    /// Event file descriptor used to wake up the thread when the watcher is destroyed.
+    int m_stop_file_descriptor;
 #endif
 
-#if !SGL_LINUX
     /// Mutex to protect the watch map.
     std::mutex m_watches_mutex;
 
     /// Mutex to protect the queued events.
     std::mutex m_queued_events_mutex;
 
-    /// Thread to poll for file system changes.
+    /// Thread to detect changes in watched directories.
     std::thread m_thread;
-    std::atomic<bool> m_stop_thread{false};
-    void thread_func();
+#if !SGL_LINUX
+    /// Signals the scan thread to stop (protected by m_watches_mutex).
+    bool m_stop_thread{false};
+    std::condition_variable m_stop_cv;
 #endif
+    void thread_func();
 };
 
 
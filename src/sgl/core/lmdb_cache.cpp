@@ -5,30 +5,42 @@
 #include "sgl/core/error.h"
 #include "sgl/core/platform.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <string_view>
 
 #include <lmdb.h>
 
 // Brief overview on how the cache works:
 // - The cache is backed by an LMDB database stored on disk.
-// - There are two databases:
+// - There are four databases:
 //   - "data": stores the actual key-value pairs.
 //   - "meta": stores meta-data for each entry (currently only last access time).
+//   - "stats": stores the total size of all values.
+//   - "sample": index from a 64-bit hash of each key to the key, used for sampled eviction.
 // - Each entry in the "data" database is identified by its key.
 // - The "meta" database uses the same keys as the "data" database to store the corresponding meta-data.
 // - When setting a value, we also update the last access time in the "meta" database.
-// - When getting a value, we update the last access time in the "meta" database.
-// - When deleting a value, we also delete the corresponding meta-data entry.
+// - When getting a value, we only use a read-only transaction and record the access time in memory.
+//   Buffered access times are written to the "meta" database in batches, when the buffer is full,
+//   after a flush interval, on eviction and when closing the cache. This avoids taking the LMDB
+//   writer lock on every read, which is shared between all processes using the same cache.
+// - When deleting a value, we also delete the corresponding meta-data and sample index entries.
+// - The total size of all values is kept in the "stats" database and updated in the same transaction
+//   whenever entries are added, overwritten, deleted or evicted. Together with the entry count maintained
+//   by LMDB itself, this allows querying cache stats in constant time.
 // - Eviction is triggered when the cache size exceeds a certain threshold (eviction_threshold),
 //   and we evict entries until the cache size is below a target size (eviction_target).
-// - Eviction is done by scanning all entries in the "meta" database, sorting them by last access time,
+// - Eviction either runs inline in set() or in a background thread (background_eviction).
+// - Exact eviction is done by scanning all entries in the "meta" database, sorting them by last access time,
 //   and deleting the least recently used entries until we are below the target size.
-//
-// Possible improvements:
-// - Instead of blocking on eviction, we could run it in a background thread.
-// - Instead of scanning all entries during eviction, we could sample a subset of entries
-//   and evict the least recently used among them. This would reduce the eviction time
-//   at the cost of not evicting the absolute least recently used entries.
+// - Sampled eviction (eviction_sample_size > 0) instead picks random entries by seeking to random hashes
+//   in the "sample" database, deleting the least recently used among them. Seeking in the "data" database
+//   directly would favor keys following large gaps in the key space (e.g. with keys sharing a common prefix,
+//   almost every seek lands on the first key). Hashes are uniformly distributed, so every entry is about
+//   equally likely to be sampled. This bounds the time the write lock is held at the cost of not evicting
+//   the absolute least recently used entries.
 
 #define LMDB_THROW(msg, error) throw sgl::LMDBException(fmt::format("{} ({})", msg, mdb_strerror(error)), error)
 
@@ -95,6 +107,87 @@ struct MetaData {
     uint64_t last_access;
 };
 
+// Stats struct.
+// This is stored as a single entry in the "stats" database.
+struct StatsData {
+    /// Total size of all values in the "data" database.
+    uint64_t size;
+};
+
+static constexpr std::string_view STATS_KEY = "stats";
+
+inline StatsData read_stats(MDB_txn* txn, unsigned int dbi_stats)
+{
+    MDB_val key = {STATS_KEY.size(), const_cast<char*>(STATS_KEY.data())};
+    MDB_val val;
+    int result = mdb_get(txn, dbi_stats, &key, &val);
+    if (result == MDB_NOTFOUND)
+        return StatsData{.size = 0};
+    if (result != MDB_SUCCESS)
+        LMDB_THROW("Failed to read stats", result);
+    StatsData stats;
+    std::memcpy(&stats, val.mv_data, sizeof(StatsData));
+    return stats;
+}
+
+inline void write_stats(MDB_txn* txn, unsigned int dbi_stats, const StatsData& stats)
+{
+    MDB_val key = {STATS_KEY.size(), const_cast<char*>(STATS_KEY.data())};
+    MDB_val val = {sizeof(StatsData), const_cast<StatsData*>(&stats)};
+    if (int result = mdb_put(txn, dbi_stats, &key, &val, 0); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to write stats", result);
+}
+
+/// Update the total size stored in the "stats" database by adding \c added and subtracting \c removed bytes.
+inline void update_stats(MDB_txn* txn, unsigned int dbi_stats, uint64_t added, uint64_t removed)
+{
+    if (added == removed)
+        return;
+    StatsData stats = read_stats(txn, dbi_stats);
+    stats.size = stats.size + added - std::min(stats.size + added, removed);
+    write_stats(txn, dbi_stats, stats);
+}
+
+/// Hash of a key in the "sample" database.
+/// The database is persistent and shared between processes, so this needs to be stable (FNV-1a with a
+/// final mix, so that keys with a common prefix are spread across the full range).
+inline uint64_t sample_hash(const void* data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<const uint8_t*>(data)[i];
+        hash *= 0x100000001b3ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/// Add a key to the "sample" database.
+inline void put_sample_key(MDB_txn* txn, unsigned int dbi_sample, const MDB_val& key)
+{
+    uint64_t hash = sample_hash(key.mv_data, key.mv_size);
+    MDB_val mdb_hash = {sizeof(hash), &hash};
+    MDB_val mdb_key = key;
+    int result = mdb_put(txn, dbi_sample, &mdb_hash, &mdb_key, MDB_NODUPDATA);
+    if (result != MDB_SUCCESS && result != MDB_KEYEXIST)
+        LMDB_THROW("Failed to write sample index", result);
+}
+
+/// Remove a key from the "sample" database.
+inline void del_sample_key(MDB_txn* txn, unsigned int dbi_sample, const MDB_val& key)
+{
+    uint64_t hash = sample_hash(key.mv_data, key.mv_size);
+    MDB_val mdb_hash = {sizeof(hash), &hash};
+    MDB_val mdb_key = key;
+    int result = mdb_del(txn, dbi_sample, &mdb_hash, &mdb_key);
+    if (result != MDB_SUCCESS && result != MDB_NOTFOUND)
+        LMDB_THROW("Failed to delete sample index", result);
+}
+
 inline uint64_t get_current_time_ns()
 {
     return static_cast<uint64_t>(
@@ -117,35 +210,128 @@ LMDBCache::LMDBCache(const std::filesystem::path& path, std::optional<Options> o
 
     m_eviction_threshold_size = (options.eviction_threshold * options.max_size) / 100;
     m_eviction_target_size = (options.eviction_target * options.max_size) / 100;
+    m_eviction_sample_size = options.eviction_sample_size;
+    m_eviction_rng.seed(get_current_time_ns());
+
+    m_access_buffer_size = options.access_buffer_size;
+    m_access_flush_interval_ns = uint64_t(options.access_flush_interval_ms) * 1000000;
+    m_last_flush_time = get_current_time_ns();
+
+    if (options.background_eviction)
+        m_eviction_thread = std::thread(&LMDBCache::eviction_thread_func, this);
 }
 
 LMDBCache::~LMDBCache()
 {
+    if (m_eviction_thread.joinable()) {
+        {
+            std::lock_guard lock(m_eviction_thread_mutex);
+            m_eviction_thread_stop = true;
+        }
+        m_eviction_thread_cv.notify_one();
+        m_eviction_thread.join();
+    }
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // Losing access times only affects eviction order.
+    }
     close_db(m_db);
 }
 
 void LMDBCache::set(const void* key_data, size_t key_size, const void* value_data, size_t value_size)
 {
-    SGL_CHECK(key_size > 0, "Key size must be greater than 0");
-    SGL_CHECK(key_size <= m_max_key_size, "Key size exceeds maximum allowed size");
+    std::span<const uint8_t> key(static_cast<const uint8_t*>(key_data), key_size);
+    std::span<const uint8_t> value(static_cast<const uint8_t*>(value_data), value_size);
+    set_many({&key, 1}, {&value, 1});
+}
+
+void LMDBCache::set_many(
+    std::span<const std::span<const uint8_t>> keys,
+    std::span<const std::span<const uint8_t>> values
+)
+{
+    SGL_CHECK(keys.size() == values.size(), "Number of keys and values must match");
+    for (const auto& key : keys) {
+        SGL_CHECK(key.size() > 0, "Key size must be greater than 0");
+        SGL_CHECK(key.size() <= m_max_key_size, "Key size exceeds maximum allowed size");
+    }
+    if (keys.empty())
+        return;
 
     // Trigger eviction if necessary.
-    if (usage().used_size > m_eviction_threshold_size)
-        evict();
+    // Sampled eviction is spread over multiple calls until the target size is reached.
+    if (m_eviction_pending || usage().used_size > m_eviction_threshold_size) {
+        if (m_eviction_thread.joinable()) {
+            {
+                std::lock_guard lock(m_eviction_thread_mutex);
+                m_eviction_requested = true;
+            }
+            m_eviction_thread_cv.notify_one();
+        } else {
+            evict(m_eviction_sample_size > 0);
+        }
+    }
 
-    ScopedTransaction txn(m_db.env);
+    // Write buffered access times in the same transaction, they are put back if writing the values fails.
+    AccessTimes access_times = take_access_times();
 
-    MDB_val mdb_key = {key_size, const_cast<void*>(key_data)};
-    MDB_val mdb_val = {value_size, const_cast<void*>(value_data)};
-    if (int result = mdb_put(txn, m_db.dbi_data, &mdb_key, &mdb_val, 0); result != MDB_SUCCESS)
-        LMDB_THROW("Failed to write data", result);
+    auto write = [&]()
+    {
+        ScopedTransaction txn(m_db.env);
 
-    MetaData meta_data{.last_access = get_current_time_ns()};
-    MDB_val mdb_val_meta = {sizeof(MetaData), &meta_data};
-    if (int result = mdb_put(txn, m_db.dbi_meta, &mdb_key, &mdb_val_meta, 0); result != MDB_SUCCESS)
-        LMDB_THROW("Failed to write metadata", result);
+        write_access_times(txn, access_times);
 
-    txn.commit();
+        MetaData meta_data{.last_access = get_current_time_ns()};
+        MDB_val mdb_val_meta = {sizeof(MetaData), &meta_data};
+
+        uint64_t added_size = 0;
+        uint64_t removed_size = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            MDB_val mdb_key = {keys[i].size(), const_cast<uint8_t*>(keys[i].data())};
+            MDB_val mdb_val;
+
+            // Get size of the existing value (if any) to update the stats.
+            int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
+            if (result == MDB_SUCCESS)
+                removed_size += mdb_val.mv_size;
+            else if (result != MDB_NOTFOUND)
+                LMDB_THROW("Failed to read data", result);
+
+            if (result == MDB_NOTFOUND)
+                put_sample_key(txn, m_db.dbi_sample, mdb_key);
+
+            mdb_val = {values[i].size(), const_cast<uint8_t*>(values[i].data())};
+            if (result = mdb_put(txn, m_db.dbi_data, &mdb_key, &mdb_val, 0); result != MDB_SUCCESS)
+                LMDB_THROW("Failed to write data", result);
+            added_size += values[i].size();
+
+            if (result = mdb_put(txn, m_db.dbi_meta, &mdb_key, &mdb_val_meta, 0); result != MDB_SUCCESS)
+                LMDB_THROW("Failed to write metadata", result);
+        }
+
+        update_stats(txn, m_db.dbi_stats, added_size, removed_size);
+
+        txn.commit();
+    };
+
+    try {
+        try {
+            write();
+        } catch (const LMDBException& e) {
+            // If the cache is full (e.g. background or incremental eviction did not keep up with writes),
+            // evict inline and retry once. Eviction takes the buffered access times into account.
+            if (e.error() != MDB_MAP_FULL)
+                throw;
+            restore_access_times(std::move(access_times));
+            evict();
+            access_times = take_access_times();
+            write();
+        }
+    } catch (...) {
+        restore_access_times(std::move(access_times));
+        throw;
+    }
 }
 
 bool LMDBCache::get(const void* key_data, size_t key_size, WriteValueFunc write_value_func, void* user_data)
@@ -153,30 +339,67 @@ bool LMDBCache::get(const void* key_data, size_t key_size, WriteValueFunc write_
     SGL_CHECK(key_size > 0, "Key size must be greater than 0");
     SGL_CHECK(key_size <= m_max_key_size, "Key size exceeds maximum allowed size");
 
-    ScopedTransaction txn(m_db.env);
-
-    MDB_val mdb_key = {key_size, const_cast<void*>(key_data)};
-    MDB_val mdb_val;
+    {
+        ScopedTransaction txn(m_db.env, MDB_RDONLY);
 
-    int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
-    if (result == MDB_NOTFOUND)
-        return false;
-    if (result != MDB_SUCCESS)
-        LMDB_THROW("Failed to read data", result);
+        MDB_val mdb_key = {key_size, const_cast<void*>(key_data)};
+        MDB_val mdb_val;
 
-    MetaData meta_data{.last_access = get_current_time_ns()};
-    MDB_val mdb_val_meta = {sizeof(MetaData), &meta_data};
-    result = mdb_put(txn, m_db.dbi_meta, &mdb_key, &mdb_val_meta, 0);
-    if (result != MDB_SUCCESS)
-        LMDB_THROW("Failed to write metadata", result);
+        int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
+        if (result == MDB_NOTFOUND)
+            return false;
+        if (result != MDB_SUCCESS)
+            LMDB_THROW("Failed to read data", result);
 
-    write_value_func(mdb_val.mv_data, mdb_val.mv_size, user_data);
+        write_value_func(mdb_val.mv_data, mdb_val.mv_size, user_data);
+    }
 
-    txn.commit();
+    if (record_access(key_data, key_size))
+        try_flush();
 
     return true;
 }
 
+size_t LMDBCache::get_many(
+    std::span<const std::span<const uint8_t>> keys,
+    WriteValuesFunc write_value_func,
+    void* user_data
+)
+{
+    for (const auto& key : keys) {
+        SGL_CHECK(key.size() > 0, "Key size must be greater than 0");
+        SGL_CHECK(key.size() <= m_max_key_size, "Key size exceeds maximum allowed size");
+    }
+
+    size_t found = 0;
+    bool should_flush = false;
+
+    {
+        ScopedTransaction txn(m_db.env, MDB_RDONLY);
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            MDB_val mdb_key = {keys[i].size(), const_cast<uint8_t*>(keys[i].data())};
+            MDB_val mdb_val;
+
+            int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
+            if (result == MDB_NOTFOUND)
+                continue;
+            if (result != MDB_SUCCESS)
+                LMDB_THROW("Failed to read data", result);
+
+            write_value_func(i, mdb_val.mv_data, mdb_val.mv_size, user_data);
+            found++;
+
+            should_flush |= record_access(keys[i].data(), keys[i].size());
+        }
+    }
+
+    if (should_flush)
+        try_flush();
+
+    return found;
+}
+
 bool LMDBCache::del(const void* key_data, size_t key_size)
 {
     SGL_CHECK(key_size > 0, "Key size must be greater than 0");
@@ -185,22 +408,109 @@ bool LMDBCache::del(const void* key_data, size_t key_size)
     ScopedTransaction txn(m_db.env);
 
     MDB_val mdb_key = {key_size, const_cast<void*>(key_data)};
+    MDB_val mdb_val;
 
-    int result = mdb_del(txn, m_db.dbi_data, &mdb_key, nullptr);
+    int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
     if (result == MDB_NOTFOUND)
         return false;
     if (result != MDB_SUCCESS)
+        LMDB_THROW("Failed to read data", result);
+    size_t value_size = mdb_val.mv_size;
+
+    if (result = mdb_del(txn, m_db.dbi_data, &mdb_key, nullptr); result != MDB_SUCCESS)
         LMDB_THROW("Failed to delete data", result);
 
     result = mdb_del(txn, m_db.dbi_meta, &mdb_key, nullptr);
     if (result != MDB_SUCCESS && result != MDB_NOTFOUND)
         LMDB_THROW("Failed to delete metadata", result);
 
+    del_sample_key(txn, m_db.dbi_sample, mdb_key);
+
+    update_stats(txn, m_db.dbi_stats, 0, value_size);
+
     txn.commit();
 
     return true;
 }
 
+void LMDBCache::flush()
+{
+    AccessTimes access_times = take_access_times();
+    if (access_times.empty())
+        return;
+
+    try {
+        ScopedTransaction txn(m_db.env);
+        write_access_times(txn, access_times);
+        txn.commit();
+    } catch (...) {
+        restore_access_times(std::move(access_times));
+        throw;
+    }
+}
+
+void LMDBCache::try_flush()
+{
+    // Failing to write access times only affects eviction order. They are kept and written on the next flush.
+    try {
+        flush();
+    } catch (const LMDBException&) {
+    }
+}
+
+bool LMDBCache::record_access(const void* key_data, size_t key_size)
+{
+    uint64_t time = get_current_time_ns();
+    std::lock_guard lock(m_access_mutex);
+    m_access_times[std::string(static_cast<const char*>(key_data), key_size)] = time;
+    return m_access_times.size() >= m_access_buffer_size || time - m_last_flush_time >= m_access_flush_interval_ns;
+}
+
+LMDBCache::AccessTimes LMDBCache::take_access_times()
+{
+    AccessTimes access_times;
+    std::lock_guard lock(m_access_mutex);
+    std::swap(access_times, m_access_times);
+    m_last_flush_time = get_current_time_ns();
+    return access_times;
+}
+
+void LMDBCache::restore_access_times(AccessTimes access_times)
+{
+    std::lock_guard lock(m_access_mutex);
+    for (auto& [key, last_access] : access_times) {
+        uint64_t& value = m_access_times[key];
+        value = std::max(value, last_access);
+    }
+}
+
+void LMDBCache::write_access_times(MDB_txn* txn, const AccessTimes& access_times)
+{
+    for (const auto& [key, last_access] : access_times) {
+        MDB_val mdb_key = {key.size(), const_cast<char*>(key.data())};
+        MDB_val mdb_val;
+
+        // Skip entries that have been deleted or evicted in the meantime.
+        int result = mdb_get(txn, m_db.dbi_data, &mdb_key, &mdb_val);
+        if (result == MDB_NOTFOUND)
+            continue;
+        if (result != MDB_SUCCESS)
+            LMDB_THROW("Failed to read data", result);
+
+        // Skip entries that have been accessed more recently (i.e. by another process).
+        result = mdb_get(txn, m_db.dbi_meta, &mdb_key, &mdb_val);
+        if (result == MDB_SUCCESS && static_cast<const MetaData*>(mdb_val.mv_data)->last_access >= last_access)
+            continue;
+        if (result != MDB_SUCCESS && result != MDB_NOTFOUND)
+            LMDB_THROW("Failed to read metadata", result);
+
+        MetaData meta_data{.last_access = last_access};
+        MDB_val mdb_val_meta = {sizeof(MetaData), &meta_data};
+        if (result = mdb_put(txn, m_db.dbi_meta, &mdb_key, &mdb_val_meta, 0); result != MDB_SUCCESS)
+            LMDB_THROW("Failed to write metadata", result);
+    }
+}
+
 LMDBCache::Usage LMDBCache::usage() const
 {
     Usage usage;
@@ -209,7 +519,13 @@ LMDBCache::Usage LMDBCache::usage() const
 
     uint64_t used_pages = 0;
     uint64_t page_size = 0;
-    for (MDB_dbi dbi : {MDB_dbi(0) /* FREE_DBI */, MDB_dbi(1) /* MAIN_DBI */, m_db.dbi_data, m_db.dbi_meta}) {
+    for (MDB_dbi dbi :
+         {MDB_dbi(0) /* FREE_DBI */,
+          MDB_dbi(1) /* MAIN_DBI */,
+          m_db.dbi_data,
+          m_db.dbi_meta,
+          m_db.dbi_stats,
+          m_db.dbi_sample}) {
         MDB_stat stat = {};
         if (int result = mdb_stat(txn, dbi, &stat); result != MDB_SUCCESS)
             LMDB_THROW("Failed to get DB stats", result);
@@ -235,41 +551,68 @@ LMDBCache::Stats LMDBCache::stats() const
     stats.evictions = m_evictions.load();
 
     ScopedTransaction txn(m_db.env, MDB_RDONLY);
-    ScopedCursor cursor(txn, m_db.dbi_data);
 
-    MDB_val key, val;
-    while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == MDB_SUCCESS) {
-        stats.entries++;
-        stats.size += val.mv_size;
-    }
+    MDB_stat stat = {};
+    if (int result = mdb_stat(txn, m_db.dbi_data, &stat); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to get DB stats", result);
+    stats.entries = stat.ms_entries;
+    stats.size = read_stats(txn, m_db.dbi_stats).size;
+    stats.last_txn_id = mdb_txn_id(txn);
 
     return stats;
 }
 
-void LMDBCache::evict()
+void LMDBCache::evict(bool incremental)
 {
-    struct Entry {
-        uint64_t last_access;
-        MDB_val key;
-    };
-    std::vector<Entry> entries;
+    std::lock_guard lock(m_eviction_mutex);
 
     size_t used_size = usage().used_size;
     // fmt::println("Evicting entries: used_size={} target_size={}", used_size, m_eviction_target_size);
-    if (used_size < m_eviction_target_size)
+    if (used_size < m_eviction_target_size) {
+        m_eviction_pending = false;
         return;
+    }
     size_t required_free_size = used_size - m_eviction_target_size;
 
-    ScopedTransaction txn(m_db.env);
-    ScopedCursor cursor(txn, m_db.dbi_meta);
-
-    // Scan all entries.
-    MDB_val key, val;
-    while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == MDB_SUCCESS) {
-        entries.push_back({
-            .last_access = static_cast<const MetaData*>(val.mv_data)->last_access,
-            .key = key,
-        });
+    // Incremental eviction only runs a single sampling step and continues on the next call.
+    if (incremental) {
+        m_eviction_pending = true;
+        evict_sampled(required_free_size, 1);
+        return;
+    }
+
+    // Write buffered access times first to evict based on the most recent access times.
+    flush();
+
+    if (m_eviction_sample_size > 0)
+        evict_sampled(required_free_size);
+    else
+        evict_exact(required_free_size);
+    m_eviction_pending = false;
+
+    // fmt::println("Eviction complete: used_size={}", usage().used_size);
+}
+
+void LMDBCache::evict_exact(size_t required_free_size)
+{
+    struct Entry {
+        uint64_t last_access;
+        std::string key;
+    };
+    std::vector<Entry> entries;
+
+    // Scan all entries in a read-only transaction.
+    // Keys are copied, as they are deleted in separate transactions.
+    {
+        ScopedTransaction txn(m_db.env, MDB_RDONLY);
+        ScopedCursor cursor(txn, m_db.dbi_meta);
+        MDB_val key, val;
+        while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == MDB_SUCCESS) {
+            entries.push_back({
+                .last_access = static_cast<const MetaData*>(val.mv_data)->last_access,
+                .key = std::string(static_cast<const char*>(key.mv_data), key.mv_size),
+            });
+        }
     }
 
     // Create heap based on last access time (oldest first).
@@ -280,27 +623,175 @@ void LMDBCache::evict()
     std::make_heap(entries.begin(), entries.end(), cmp);
 
     // Evict entries until we are below the target size.
-    size_t evictions = 0;
+    // Deleting in batches keeps transactions small. A single large transaction needs to copy most pages
+    // of the database, which can exceed the map size when evicting many small entries.
+    static constexpr size_t BATCH_SIZE = 256;
     while (required_free_size > 0 && !entries.empty()) {
-        std::pop_heap(entries.begin(), entries.end(), cmp);
-        Entry& entry = entries.back();
-        if (int result = mdb_get(txn, m_db.dbi_data, &entry.key, &val); result != MDB_SUCCESS)
-            LMDB_THROW("Failed to get data during eviction", result);
-        required_free_size -= std::min(required_free_size, val.mv_size);
-        if (int result = mdb_del(txn, m_db.dbi_data, &entry.key, nullptr); result != MDB_SUCCESS)
-            LMDB_THROW("Failed to delete data during eviction", result);
-        if (int result = mdb_del(txn, m_db.dbi_meta, &entry.key, nullptr); result != MDB_SUCCESS)
-            LMDB_THROW("Failed to delete metadata during eviction", result);
-        entries.pop_back();
-        evictions++;
+        ScopedTransaction txn(m_db.env);
+        size_t evictions = 0;
+        size_t evicted_size = 0;
+        while (required_free_size > 0 && !entries.empty() && evictions < BATCH_SIZE) {
+            std::pop_heap(entries.begin(), entries.end(), cmp);
+            Entry& entry = entries.back();
+            MDB_val key = {entry.key.size(), entry.key.data()};
+            MDB_val val;
+            int result = mdb_get(txn, m_db.dbi_data, &key, &val);
+            if (result == MDB_SUCCESS) {
+                required_free_size -= std::min(required_free_size, val.mv_size);
+                evicted_size += val.mv_size;
+                if (result = mdb_del(txn, m_db.dbi_data, &key, nullptr); result != MDB_SUCCESS)
+                    LMDB_THROW("Failed to delete data during eviction", result);
+                evictions++;
+            } else if (result != MDB_NOTFOUND) {
+                LMDB_THROW("Failed to get data during eviction", result);
+            }
+            // Entries without data are stale (or have been deleted in the meantime), drop what is left of them.
+            if (result = mdb_del(txn, m_db.dbi_meta, &key, nullptr); result != MDB_SUCCESS && result != MDB_NOTFOUND)
+                LMDB_THROW("Failed to delete metadata during eviction", result);
+            del_sample_key(txn, m_db.dbi_sample, key);
+            entries.pop_back();
+        }
+        update_stats(txn, m_db.dbi_stats, 0, evicted_size);
+        txn.commit();
+
+        m_evictions.fetch_add(evictions);
     }
+}
 
-    cursor.close();
-    txn.commit();
+void LMDBCache::evict_sampled(size_t required_free_size, size_t max_steps)
+{
+    struct Entry {
+        uint64_t last_access;
+        std::string key;
+    };
+    std::vector<Entry> entries;
 
-    // fmt::println("Eviction complete: used_size={} evictions={}", usage().used_size, evictions);
+    // Evict in steps, each in a short transaction, so the writer lock is never held for long.
+    for (size_t step = 0; step < max_steps && required_free_size > 0; ++step) {
+        ScopedTransaction txn(m_db.env);
+
+        // Write buffered access times in the same transaction, so victims are picked by their latest access.
+        AccessTimes access_times = take_access_times();
+        try {
+            write_access_times(txn, access_times);
+
+            // Sample entries by seeking to random hashes in the sample index.
+            ScopedCursor cursor(txn, m_db.dbi_sample);
+            entries.clear();
+            for (uint32_t i = 0; i < m_eviction_sample_size; ++i) {
+                uint64_t random_hash = m_eviction_rng();
+                MDB_val hash = {sizeof(random_hash), &random_hash};
+                MDB_val key;
+                int result = mdb_cursor_get(cursor, &hash, &key, MDB_SET_RANGE);
+                if (result == MDB_NOTFOUND)
+                    result = mdb_cursor_get(cursor, &hash, &key, MDB_FIRST);
+                if (result == MDB_NOTFOUND)
+                    break;
+                if (result != MDB_SUCCESS)
+                    LMDB_THROW("Failed to sample entries during eviction", result);
+                MDB_val val;
+                result = mdb_get(txn, m_db.dbi_meta, &key, &val);
+                if (result != MDB_SUCCESS && result != MDB_NOTFOUND)
+                    LMDB_THROW("Failed to read metadata during eviction", result);
+                // Keys are copied, as deleting entries can invalidate pointers into the database.
+                entries.push_back({
+                    .last_access = result == MDB_SUCCESS ? static_cast<const MetaData*>(val.mv_data)->last_access : 0,
+                    .key = std::string(static_cast<const char*>(key.mv_data), key.mv_size),
+                });
+            }
+            cursor.close();
+            if (entries.empty()) {
+                txn.commit();
+                break;
+            }
+
+            // Remove duplicates and sort by last access time (oldest first).
+            std::sort(
+                entries.begin(),
+                entries.end(),
+                [](const Entry& a, const Entry& b)
+                {
+                    return a.key < b.key;
+                }
+            );
+            entries.erase(
+                std::unique(
+                    entries.begin(),
+                    entries.end(),
+                    [](const Entry& a, const Entry& b)
+                    {
+                        return a.key == b.key;
+                    }
+                ),
+                entries.end()
+            );
+            std::sort(
+                entries.begin(),
+                entries.end(),
+                [](const Entry& a, const Entry& b)
+                {
+                    return a.last_access < b.last_access;
+                }
+            );
+
+            // Evict the oldest quarter of the sampled entries.
+            size_t evict_count = std::max<size_t>(1, entries.size() / 4);
+            size_t evictions = 0;
+            size_t evicted_size = 0;
+            for (size_t i = 0; i < evict_count && required_free_size > 0; ++i) {
+                MDB_val key = {entries[i].key.size(), entries[i].key.data()};
+                MDB_val val;
+                int result = mdb_get(txn, m_db.dbi_data, &key, &val);
+                if (result == MDB_SUCCESS) {
+                    required_free_size -= std::min(required_free_size, val.mv_size);
+                    evicted_size += val.mv_size;
+                    if (result = mdb_del(txn, m_db.dbi_data, &key, nullptr); result != MDB_SUCCESS)
+                        LMDB_THROW("Failed to delete data during eviction", result);
+                    evictions++;
+                } else if (result != MDB_NOTFOUND) {
+                    LMDB_THROW("Failed to get data during eviction", result);
+                }
+                // A sampled key without data is stale. Drop its metadata and sample index entry, otherwise it
+                // would be sampled (and fail eviction) again and again.
+                result = mdb_del(txn, m_db.dbi_meta, &key, nullptr);
+                if (result != MDB_SUCCESS && result != MDB_NOTFOUND)
+                    LMDB_THROW("Failed to delete metadata during eviction", result);
+                del_sample_key(txn, m_db.dbi_sample, key);
+            }
+
+            update_stats(txn, m_db.dbi_stats, 0, evicted_size);
+            txn.commit();
+
+            m_evictions.fetch_add(evictions);
+        } catch (...) {
+            restore_access_times(std::move(access_times));
+            throw;
+        }
+    }
+}
 
-    m_evictions.fetch_add(evictions);
+void LMDBCache::eviction_thread_func()
+{
+    std::unique_lock lock(m_eviction_thread_mutex);
+    while (true) {
+        m_eviction_thread_cv.wait(
+            lock,
+            [this]
+            {
+                return m_eviction_requested || m_eviction_thread_stop;
+            }
+        );
+        if (m_eviction_thread_stop)
+            break;
+        m_eviction_requested = false;
+        lock.unlock();
+        try {
+            evict();
+        } catch (const std::exception&) {
+            // Eviction is retried on the next request (or inline when the cache is full).
+        }
+        lock.lock();
+    }
 }
 
 // LMDB doesn't support opening the same DB environment multiple times in the same process.
@@ -340,7 +831,7 @@ LMDBCache::DB LMDBCache::open_db(const std::filesystem::path& path, const Option
         LMDB_THROW("Failed to create environment", result);
     if (int result = mdb_env_set_maxreaders(db.env, 126); result != MDB_SUCCESS)
         LMDB_THROW("Failed to set max readers", result);
-    if (int result = mdb_env_set_maxdbs(db.env, 2); result != MDB_SUCCESS)
+    if (int result = mdb_env_set_maxdbs(db.env, 4); result != MDB_SUCCESS)
         LMDB_THROW("Failed to set max DBs", result);
     if (int result = mdb_env_set_mapsize(db.env, options.max_size); result != MDB_SUCCESS)
         LMDB_THROW("Failed to set map size", result);
@@ -355,6 +846,41 @@ LMDBCache::DB LMDBCache::open_db(const std::filesystem::path& path, const Option
         LMDB_THROW("Failed to open data DB", result);
     if (int result = mdb_dbi_open(txn, "meta", MDB_CREATE, &db.dbi_meta); result != MDB_SUCCESS)
         LMDB_THROW("Failed to open meta DB", result);
+    if (int result = mdb_dbi_open(txn, "stats", MDB_CREATE, &db.dbi_stats); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to open stats DB", result);
+    if (int result = mdb_dbi_open(txn, "sample", MDB_CREATE | MDB_DUPSORT, &db.dbi_sample); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to open sample DB", result);
+
+    // Initialize stats for caches created before stats were stored.
+    MDB_val stats_key = {STATS_KEY.size(), const_cast<char*>(STATS_KEY.data())};
+    MDB_val stats_val;
+    if (int result = mdb_get(txn, db.dbi_stats, &stats_key, &stats_val); result == MDB_NOTFOUND) {
+        StatsData stats{.size = 0};
+        ScopedCursor cursor(txn, db.dbi_data);
+        MDB_val key, val;
+        while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == MDB_SUCCESS)
+            stats.size += val.mv_size;
+        cursor.close();
+        write_stats(txn, db.dbi_stats, stats);
+    } else if (result != MDB_SUCCESS) {
+        LMDB_THROW("Failed to read stats", result);
+    }
+
+    // Build the sample index for caches created before it was stored.
+    MDB_stat data_stat = {};
+    MDB_stat sample_stat = {};
+    if (int result = mdb_stat(txn, db.dbi_data, &data_stat); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to get DB stats", result);
+    if (int result = mdb_stat(txn, db.dbi_sample, &sample_stat); result != MDB_SUCCESS)
+        LMDB_THROW("Failed to get DB stats", result);
+    if (sample_stat.ms_entries != data_stat.ms_entries) {
+        if (int result = mdb_drop(txn, db.dbi_sample, 0); result != MDB_SUCCESS)
+            LMDB_THROW("Failed to clear sample DB", result);
+        ScopedCursor cursor(txn, db.dbi_data);
+        MDB_val key, val;
+        while (mdb_cursor_get(cursor, &key, &val, MDB_NEXT) == MDB_SUCCESS)
+            put_sample_key(txn, db.dbi_sample, key);
+    }
 
     txn.commit();
 
@@ -387,6 +913,8 @@ void LMDBCache::close_db(DB db)
     if (--it->ref_count == 0) {
         mdb_dbi_close(db.env, db.dbi_data);
         mdb_dbi_close(db.env, db.dbi_meta);
+        mdb_dbi_close(db.env, db.dbi_stats);
+        mdb_dbi_close(db.env, db.dbi_sample);
         mdb_env_close(db.env);
         s_db_cache.erase(it);
     }
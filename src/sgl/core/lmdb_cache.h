@@ -5,13 +5,20 @@
 #include "sgl/core/object.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <random>
 #include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <optional>
 
 // Forward declaration
 struct MDB_env;
+struct MDB_txn;
 
 namespace sgl {
 
@@ -35,10 +42,13 @@ private:
 /// This class provides a simple key-value cache that stores its data in an LMDB database on disk.
 /// It supports basic operations such as setting, getting, and deleting entries.
 /// Eviction uses an LRU policy and is triggered when the cache size exceeds the eviction threshold.
+/// Eviction can either run inline in \c set() or in a background thread, and can either use exact LRU
+/// (scanning all entries) or approximate LRU (sampling random entries).
 class SGL_API LMDBCache : public Object {
     SGL_OBJECT(LMDBCache)
 public:
     using WriteValueFunc = void (*)(const void* data, size_t size, void* user_data);
+    using WriteValuesFunc = void (*)(size_t index, const void* data, size_t size, void* user_data);
 
     struct Options {
         /// Maximum size of the cache on disk.
@@ -49,10 +59,24 @@ public:
         /// Eviction target in percent (0-100). When eviction is triggered, entries
         /// are evicted until the cache size is below this percentage of the maximum size.
         uint32_t eviction_target = 60;
+        /// Run eviction in a background thread instead of blocking \c set().
+        /// If the cache fills up before the background thread catches up, \c set() evicts inline.
+        bool background_eviction = false;
+        /// Number of randomly sampled entries per eviction step (approximate LRU).
+        /// The oldest quarter of each sample is evicted, each step in a separate transaction.
+        /// Without a background thread, \c set() runs one step per call until the target size is reached.
+        /// If 0, eviction scans all entries and evicts the least recently used ones (exact LRU).
+        uint32_t eviction_sample_size = 0;
         /// Disable synchronous writes to improve performance at the cost of potential data loss
         /// in case of a crash. This is equivalent to opening the LMDB environment with the
         /// `MDB_NOSYNC` flag.
         bool nosync = true;
+        /// Maximum number of access times buffered in memory before they are written to the database.
+        /// Reads only use read-only transactions, access times are written in batches.
+        uint32_t access_buffer_size = 1024;
+        /// Maximum time in milliseconds access times are buffered in memory before they are written
+        /// to the database (checked when reading from the cache).
+        uint32_t access_flush_interval_ms = 1000;
     };
 
     struct Usage {
@@ -71,6 +95,8 @@ public:
         uint64_t size{0};
         /// Eviction count (number of entries evicted since opening).
         uint64_t evictions{0};
+        /// ID of the last committed write transaction (including transactions of other processes).
+        uint64_t last_txn_id{0};
     };
 
     /// Constructor.
@@ -100,6 +126,27 @@ public:
     /// \return True if the key was found, false otherwise.
     bool get(const void* key_data, size_t key_size, WriteValueFunc write_value_func, void* user_data = nullptr);
 
+    /// Set multiple values in the cache in a single transaction.
+    /// Either all or none of the values are written.
+    /// Throws on error.
+    /// \param keys Keys.
+    /// \param values Values (same number as keys).
+    void set_many(std::span<const std::span<const uint8_t>> keys, std::span<const std::span<const uint8_t>> values);
+
+    /// Get multiple values from the cache in a single read-only transaction.
+    /// \c write_value_func is called for each key that was found, with the index of the key.
+    /// The value data points directly into the database and is only valid during the call.
+    /// Throws on error.
+    /// \param keys Keys.
+    /// \param write_value_func Function to write the value data.
+    /// \param user_data User data passed to the write_value_func.
+    /// \return Number of keys that were found.
+    size_t get_many(
+        std::span<const std::span<const uint8_t>> keys,
+        WriteValuesFunc write_value_func,
+        void* user_data = nullptr
+    );
+
     /// Delete a value from the cache.
     /// Throws on error.
     /// \param key_data Pointer to the key data.
@@ -143,16 +190,39 @@ public:
     /// \return True if the key was found and deleted, false if the key was not found.
     inline bool del(std::span<const uint8_t> key) { return del(key.data(), key.size()); }
 
+    /// Write buffered access times to the database.
+    /// This is done automatically when the buffer is full, when writing values, on eviction and when closing the cache.
+    /// Throws on error.
+    void flush();
+
     Usage usage() const;
     Stats stats() const;
 
 private:
-    void evict();
+    void evict(bool incremental = false);
+    void evict_exact(size_t required_free_size);
+    void evict_sampled(size_t required_free_size, size_t max_steps = SIZE_MAX);
+    void eviction_thread_func();
+
+    using AccessTimes = std::unordered_map<std::string, uint64_t>;
+
+    /// Flush buffered access times, ignoring errors.
+    void try_flush();
+    /// Record access time of an entry. Returns true if buffered access times should be flushed.
+    bool record_access(const void* key_data, size_t key_size);
+    /// Take all buffered access times.
+    AccessTimes take_access_times();
+    /// Put back access times that failed to be written.
+    void restore_access_times(AccessTimes access_times);
+    /// Write access times to the meta database.
+    void write_access_times(MDB_txn* txn, const AccessTimes& access_times);
 
     struct DB {
         MDB_env* env{nullptr};
         unsigned int dbi_data{0};
         unsigned int dbi_meta{0};
+        unsigned int dbi_stats{0};
+        unsigned int dbi_sample{0};
     };
 
     static DB open_db(const std::filesystem::path& path, const Options& options);
@@ -166,6 +236,25 @@ private:
 
     size_t m_eviction_threshold_size{0};
     size_t m_eviction_target_size{0};
+    uint32_t m_eviction_sample_size{0};
+
+    /// Serializes eviction (background thread and inline fallback).
+    std::mutex m_eviction_mutex;
+    std::mt19937_64 m_eviction_rng;
+    /// Set while incremental eviction has not reached the target size yet.
+    std::atomic<bool> m_eviction_pending{false};
+
+    std::thread m_eviction_thread;
+    std::mutex m_eviction_thread_mutex;
+    std::condition_variable m_eviction_thread_cv;
+    bool m_eviction_requested{false};
+    bool m_eviction_thread_stop{false};
+
+    size_t m_access_buffer_size{0};
+    uint64_t m_access_flush_interval_ns{0};
+    std::mutex m_access_mutex;
+    AccessTimes m_access_times;
+    uint64_t m_last_flush_time{0};
 
     SGL_NON_COPYABLE_AND_MOVABLE(LMDBCache);
 
@@ -14,6 +14,10 @@ namespace sgl {
 static void (*object_inc_ref_py)(PyObject*) noexcept = nullptr;
 static void (*object_dec_ref_py)(PyObject*) noexcept = nullptr;
 static Py_ssize_t_ (*object_ref_cnt_py)(PyObject*) noexcept = nullptr;
+static int (*object_gil_acquire_py)() noexcept = nullptr;
+static void (*object_gil_release_py)(int) noexcept = nullptr;
+static void* (*object_gil_save_py)() noexcept = nullptr;
+static void (*object_gil_restore_py)(void*) noexcept = nullptr;
 
 #if SGL_ENABLE_OBJECT_TRACKING
 static std::mutex s_tracked_objects_mutex;
@@ -60,14 +64,15 @@ void Object::dec_ref(bool dealloc) const noexcept
                 fprintf(stderr, "Object::dec_ref(%p): reference count underflow!", this);
                 abort();
             } else if (value == 3) {
-                if (dealloc) {
+                // Drop to zero before deallocating, so a concurrent try_inc_ref() can't revive the object.
+                // Acquire pairs with the release of other decrements so their accesses happen before deletion.
+                if (!m_state.compare_exchange_weak(value, 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    continue;
+                if (dealloc)
                     delete this;
-                } else {
-                    m_state.store(1, std::memory_order_relaxed);
-                }
             } else {
                 if (!m_state
-                         .compare_exchange_weak(value, value - 2, std::memory_order_relaxed, std::memory_order_relaxed))
+                         .compare_exchange_weak(value, value - 2, std::memory_order_release, std::memory_order_relaxed))
                     continue;
             }
         } else {
@@ -77,6 +82,28 @@ void Object::dec_ref(bool dealloc) const noexcept
     }
 }
 
+bool Object::try_inc_ref(bool gil_held) const noexcept
+{
+    uintptr_t value = m_state.load(std::memory_order_relaxed);
+
+    while (true) {
+        if (value & 1) {
+            if (value == 1)
+                return false;
+            if (!m_state.compare_exchange_weak(value, value + 2, std::memory_order_relaxed, std::memory_order_relaxed))
+                continue;
+        } else {
+            // Python objects are deallocated while holding the GIL, so checking and increasing the
+            // reference count is only atomic if the caller holds the GIL throughout.
+            if (!gil_held || object_ref_cnt_py((PyObject*)value) == 0)
+                return false;
+            object_inc_ref_py((PyObject*)value);
+        }
+
+        return true;
+    }
+}
+
 uint64_t Object::ref_count() const
 {
     uintptr_t value = m_state.load(std::memory_order_relaxed);
@@ -89,16 +116,19 @@ uint64_t Object::ref_count() const
 void Object::set_self_py(PyObject* o) noexcept
 {
     uintptr_t value = m_state.load(std::memory_order_relaxed);
-    if (value & 1) {
+    while (value & 1) {
+        // Other threads may concurrently change the C++ reference count (e.g. via try_inc_ref()).
+        // Transferring the count after the exchange is safe, as they need the GIL once the object is owned by
+        // Python and nanobind calls this while holding it.
+        if (!m_state.compare_exchange_weak(value, (uintptr_t)o, std::memory_order_acq_rel, std::memory_order_relaxed))
+            continue;
         value >>= 1;
         for (uintptr_t i = 0; i < value; ++i)
             object_inc_ref_py(o);
-
-        m_state.store((uintptr_t)o);
-    } else {
-        fprintf(stderr, "Object::set_self_py(%p): a Python object was already present!", this);
-        abort();
+        return;
     }
+    fprintf(stderr, "Object::set_self_py(%p): a Python object was already present!", this);
+    abort();
 }
 
 std::string Object::to_string() const
@@ -197,12 +227,44 @@ void Object::set_enable_ref_tracking(bool enable)
 void object_init_py(
     void (*object_inc_ref_py_)(PyObject*) noexcept,
     void (*object_dec_ref_py_)(PyObject*) noexcept,
-    Py_ssize_t_ (*object_ref_cnt_py_)(PyObject*) noexcept
+    Py_ssize_t_ (*object_ref_cnt_py_)(PyObject*) noexcept,
+    int (*object_gil_acquire_py_)() noexcept,
+    void (*object_gil_release_py_)(int) noexcept,
+    void* (*object_gil_save_py_)() noexcept,
+    void (*object_gil_restore_py_)(void*) noexcept
 )
 {
     object_inc_ref_py = object_inc_ref_py_;
     object_dec_ref_py = object_dec_ref_py_;
     object_ref_cnt_py = object_ref_cnt_py_;
+    object_gil_acquire_py = object_gil_acquire_py_;
+    object_gil_release_py = object_gil_release_py_;
+    object_gil_save_py = object_gil_save_py_;
+    object_gil_restore_py = object_gil_restore_py_;
+}
+
+PyGILGuard::PyGILGuard() noexcept
+{
+    if (object_gil_acquire_py)
+        m_state = object_gil_acquire_py();
+}
+
+PyGILGuard::~PyGILGuard() noexcept
+{
+    if (object_gil_acquire_py)
+        object_gil_release_py(m_state);
+}
+
+PyGILRelease::PyGILRelease() noexcept
+{
+    if (object_gil_save_py)
+        m_state = object_gil_save_py();
+}
+
+PyGILRelease::~PyGILRelease() noexcept
+{
+    if (m_state)
+        object_gil_restore_py(m_state);
 }
 
 } // namespace sgl
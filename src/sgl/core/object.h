@@ -128,6 +128,14 @@ public:
     /// Decrease the object's reference count and potentially deallocate it.
     void dec_ref(bool dealloc = true) const noexcept;
 
+    /// Increase the object's reference count, unless it has already dropped to zero.
+    /// Allows caches holding plain pointers to safely retain objects that may be destroyed concurrently,
+    /// as long as the object is only deallocated after being removed from the cache.
+    /// Objects owned by Python are only retained if \c gil_held is set, in which case the caller must hold
+    /// the GIL (see \c PyGILGuard) for the whole lookup, as Python deallocates objects while holding it.
+    /// \return True if the reference count was increased.
+    bool try_inc_ref(bool gil_held = false) const noexcept;
+
     /// Return current reference count.
     uint64_t ref_count() const;
 
@@ -198,9 +206,51 @@ public:
 SGL_API void object_init_py(
     void (*object_inc_ref_py)(PyObject*) noexcept,
     void (*object_dec_ref_py)(PyObject*) noexcept,
-    Py_ssize_t_ (*object_ref_cnt_py)(PyObject*) noexcept
+    Py_ssize_t_ (*object_ref_cnt_py)(PyObject*) noexcept,
+    int (*object_gil_acquire_py)() noexcept = nullptr,
+    void (*object_gil_release_py)(int) noexcept = nullptr,
+    void* (*object_gil_save_py)() noexcept = nullptr,
+    void (*object_gil_restore_py)(void*) noexcept = nullptr
 );
 
+/**
+ * \brief Scoped acquisition of the Python GIL.
+ *
+ * Uses the handlers installed with `object_init_py` (i.e. `PyGILState_Ensure` /
+ * `PyGILState_Release`) and does nothing if Python support is not initialized.
+ * Needed by C++ code that retains objects possibly owned by Python, see `Object::try_inc_ref()`.
+ */
+class SGL_API PyGILGuard {
+public:
+    PyGILGuard() noexcept;
+    ~PyGILGuard() noexcept;
+
+    PyGILGuard(const PyGILGuard&) = delete;
+    PyGILGuard& operator=(const PyGILGuard&) = delete;
+
+private:
+    int m_state{0};
+};
+
+/**
+ * \brief Scoped release of the Python GIL.
+ *
+ * Releases the GIL if the calling thread holds it (i.e. `PyEval_SaveThread` /
+ * `PyEval_RestoreThread`) and does nothing otherwise. Needed by C++ code that blocks on a lock
+ * whose holder may acquire the GIL, see `SlangSession::_lock()`.
+ */
+class SGL_API PyGILRelease {
+public:
+    PyGILRelease() noexcept;
+    ~PyGILRelease() noexcept;
+
+    PyGILRelease(const PyGILRelease&) = delete;
+    PyGILRelease& operator=(const PyGILRelease&) = delete;
+
+private:
+    void* m_state{nullptr};
+};
+
 
 #if SGL_ENABLE_REF_TRACKING
 namespace detail {
@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "buffer_pool.h"
+
+#include "sgl/device/device.h"
+#include "sgl/device/command.h"
+#include "sgl/device/resource.h"
+
+#include "sgl/core/error.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace sgl {
+
+BufferPool::BufferPool(Device* device)
+    : m_device(device)
+{
+}
+
+BufferPool::~BufferPool() { }
+
+ref<Buffer> BufferPool::allocate(const BufferDesc& desc)
+{
+    SGL_CHECK(desc.data == nullptr, "Pooled buffers cannot have initial data.");
+    SGL_CHECK(desc.resource_type_layout == nullptr, "Pooled buffers must use 'struct_size' instead of a type layout.");
+
+    size_t size = desc.element_count > 0 ? desc.element_count * desc.struct_size : desc.size;
+
+    std::unique_lock lock(m_mutex);
+    if (!m_enabled) {
+        lock.unlock();
+        return m_device->create_buffer(desc);
+    }
+
+    Key key{
+        .usage = desc.usage,
+        .memory_type = desc.memory_type,
+        .struct_size = desc.struct_size,
+        .size = bucket_size(size, desc.struct_size),
+    };
+
+    // Only scan the buffers in use for released ones if no free buffer is available.
+    auto take_free = [&]() -> ref<Buffer>
+    {
+        auto it = m_free.find(key);
+        if (it == m_free.end() || it->second.empty())
+            return nullptr;
+        ref<Buffer> free_buffer = std::move(it->second.back());
+        it->second.pop_back();
+        m_free_count--;
+        m_free_size -= key.size;
+        return free_buffer;
+    };
+    update();
+    ref<Buffer> buffer = take_free();
+    if (!buffer) {
+        collect();
+        update();
+        buffer = take_free();
+    }
+
+    if (buffer) {
+        m_hit_count++;
+        m_pending_clears.push_back(buffer);
+    } else {
+        m_miss_count++;
+        BufferDesc pool_desc = desc;
+        pool_desc.size = key.size;
+        pool_desc.element_count = 0;
+        buffer = m_device->create_buffer(pool_desc);
+    }
+
+    m_used.emplace_back(key, buffer);
+    return buffer;
+}
+
+void BufferPool::clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_used.clear();
+    m_released.clear();
+    m_retired.clear();
+    m_free.clear();
+    m_free_count = 0;
+    m_free_size = 0;
+}
+
+bool BufferPool::enabled() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_enabled;
+}
+
+void BufferPool::set_enabled(bool enabled)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_enabled = enabled;
+    }
+    if (!enabled)
+        clear();
+}
+
+void BufferPool::set_max_free_size(size_t max_free_size)
+{
+    std::lock_guard lock(m_mutex);
+    m_max_free_size = max_free_size;
+    trim();
+}
+
+BufferPoolStats BufferPool::stats() const
+{
+    std::lock_guard lock(m_mutex);
+    return {
+        .hit_count = m_hit_count,
+        .miss_count = m_miss_count,
+        .used_count = m_used.size(),
+        .free_count = m_free_count,
+        .free_size = m_free_size,
+    };
+}
+
+size_t BufferPool::bucket_size(size_t size, size_t struct_size)
+{
+    // Round up to a quarter of the next lower power of two, wasting at most 25%.
+    size_t bucket = 256;
+    if (size > bucket) {
+        size_t step = std::bit_floor(size) / 4;
+        bucket = (size + step - 1) / step * step;
+    }
+    if (struct_size > 1)
+        bucket = (bucket + struct_size - 1) / struct_size * struct_size;
+    return bucket;
+}
+
+ref<CommandBuffer> BufferPool::_record_clears()
+{
+    std::vector<ref<Buffer>> buffers;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_pending_clears.empty())
+            return nullptr;
+        buffers = std::move(m_pending_clears);
+        m_pending_clears.clear();
+    }
+
+    ref<CommandEncoder> command_encoder = m_device->create_command_encoder();
+    for (Buffer* buffer : buffers)
+        command_encoder->clear_buffer(buffer);
+    return command_encoder->finish();
+}
+
+void BufferPool::collect()
+{
+    // Checking all buffers in use on every miss would make allocation O(n) in the number of live buffers.
+    // Check a bounded number instead, cycling through all of them over consecutive calls.
+    static constexpr size_t MAX_COLLECT_COUNT = 64;
+
+    // A released buffer may still be recorded in any command encoder created so far.
+    uint64_t command_encoder_id = m_device->_last_command_encoder_id();
+
+    for (size_t count = std::min(m_used.size(), MAX_COLLECT_COUNT); count > 0; --count) {
+        auto [key, buffer] = std::move(m_used.front());
+        m_used.pop_front();
+        uint64_t ref_count = buffer->ref_count();
+        if (ref_count == 1) {
+            m_released.push_back({.key = key, .buffer = std::move(buffer), .command_encoder_id = command_encoder_id});
+            m_free_count++;
+            m_free_size += key.size;
+        } else if (ref_count > 1) {
+            m_used.emplace_back(key, std::move(buffer));
+        }
+        // A reference count of 0 means the buffer is owned by a Python object, in which case
+        // the reference count is unknown. Stop tracking it and let it be released normally.
+    }
+
+    trim();
+}
+
+void BufferPool::update()
+{
+    // Once all command encoders that may have recorded a released buffer are submitted (or dropped),
+    // the last submit id covers all work using it.
+    uint64_t oldest_pending = m_device->_oldest_pending_command_encoder_id();
+    uint64_t submit_id = m_device->last_submit_id();
+    while (!m_released.empty() && m_released.front().command_encoder_id < oldest_pending) {
+        ReleasedBuffer& released = m_released.front();
+        m_retired.push_back({.key = released.key, .buffer = std::move(released.buffer), .submit_id = submit_id});
+        m_released.pop_front();
+    }
+
+    while (!m_retired.empty() && m_device->is_submit_finished(m_retired.front().submit_id)) {
+        RetiredBuffer& retired = m_retired.front();
+        m_free[retired.key].push_back(std::move(retired.buffer));
+        m_retired.pop_front();
+    }
+}
+
+void BufferPool::trim()
+{
+    // Release buffers ready for reuse first, then the ones waiting the longest.
+    for (auto it = m_free.begin(); it != m_free.end() && m_free_size > m_max_free_size;) {
+        auto& free_buffers = it->second;
+        while (!free_buffers.empty() && m_free_size > m_max_free_size) {
+            free_buffers.pop_back();
+            m_free_count--;
+            m_free_size -= it->first.size;
+        }
+        it = free_buffers.empty() ? m_free.erase(it) : std::next(it);
+    }
+    while (!m_retired.empty() && m_free_size > m_max_free_size) {
+        m_free_count--;
+        m_free_size -= m_retired.front().key.size;
+        m_retired.pop_front();
+    }
+    while (!m_released.empty() && m_free_size > m_max_free_size) {
+        m_free_count--;
+        m_free_size -= m_released.front().key.size;
+        m_released.pop_front();
+    }
+}
+
+} // namespace sgl
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include "sgl/device/fwd.h"
+#include "sgl/device/resource.h"
+
+#include "sgl/core/object.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace sgl {
+
+struct BufferPoolStats {
+    /// Number of allocations served from the pool.
+    size_t hit_count;
+    /// Number of allocations that created a new buffer.
+    size_t miss_count;
+    /// Number of pooled buffers currently handed out.
+    size_t used_count;
+    /// Number of pooled buffers available for reuse (including ones still in use by the GPU).
+    size_t free_count;
+    /// Total size in bytes of buffers available for reuse.
+    size_t free_size;
+};
+
+/**
+ * \brief Pool of device buffers, used for short lived buffers such as function call outputs.
+ *
+ * Buffers are bucketed by usage, memory type, struct size and size. Sizes are rounded up,
+ * so a pooled buffer can be larger than requested. A buffer handed out by the pool is
+ * recycled once the pool holds the only reference to it. At that point it may still be
+ * recorded in command encoders that were created before, so it is retired with the submit
+ * id that covers all of them once they are submitted, and reused when that submit has finished.
+ * Reused buffers are cleared to zero by the next submit, ahead of any command using them.
+ */
+class SGL_API BufferPool : public Object {
+    SGL_OBJECT(BufferPool)
+public:
+    BufferPool(Device* device);
+    ~BufferPool();
+
+    /**
+     * \brief Allocate a buffer.
+     *
+     * \param desc Buffer description. Initial data is not supported.
+     * \return Buffer with at least the requested size.
+     */
+    ref<Buffer> allocate(const BufferDesc& desc);
+
+    /// Release all free buffers and stop tracking buffers in use.
+    void clear();
+
+    /// Pooling enabled. If disabled, buffers of the requested size are created for every allocation
+    /// and free buffers are released.
+    bool enabled() const;
+    void set_enabled(bool enabled);
+
+    /// Maximum total size in bytes of free buffers kept for reuse.
+    size_t max_free_size() const { return m_max_free_size; }
+    void set_max_free_size(size_t max_free_size);
+
+    /// Pool statistics.
+    BufferPoolStats stats() const;
+
+    /// Round a buffer size up to its pool bucket size.
+    static size_t bucket_size(size_t size, size_t struct_size);
+
+    /// Record clearing the reused buffers handed out since the last call, or return null if there are none.
+    /// Called by the device when submitting command buffers, the returned command buffer is submitted first.
+    ref<CommandBuffer> _record_clears();
+
+private:
+    struct Key {
+        BufferUsage usage;
+        MemoryType memory_type;
+        size_t struct_size;
+        size_t size;
+        auto operator<=>(const Key&) const = default;
+    };
+
+    struct ReleasedBuffer {
+        Key key;
+        ref<Buffer> buffer;
+        /// Last command encoder that may have recorded the buffer.
+        uint64_t command_encoder_id;
+    };
+
+    struct RetiredBuffer {
+        Key key;
+        ref<Buffer> buffer;
+        /// Submission that must be finished before the buffer can be reused.
+        uint64_t submit_id;
+    };
+
+    /// Move buffers that are only referenced by the pool to the released queue.
+    /// Only checks a bounded number of buffers in use per call, continuing where the last call stopped.
+    void collect();
+    /// Retire released buffers whose command encoders are submitted and free retired buffers whose
+    /// submission has finished.
+    void update();
+    void trim();
+
+    Device* m_device;
+    mutable std::mutex m_mutex;
+    /// Buffers handed out by the pool, in the order they are checked by \c collect.
+    std::deque<std::pair<Key, ref<Buffer>>> m_used;
+    /// Released buffers, ordered by command encoder id.
+    std::deque<ReleasedBuffer> m_released;
+    /// Retired buffers, ordered by submit id.
+    std::deque<RetiredBuffer> m_retired;
+    /// Buffers ready for reuse.
+    std::map<Key, std::vector<ref<Buffer>>> m_free;
+    /// Reused buffers that need to be cleared before they are used.
+    std::vector<ref<Buffer>> m_pending_clears;
+    bool m_enabled{true};
+    size_t m_max_free_size{256ull * 1024 * 1024};
+    size_t m_free_count{0};
+    size_t m_free_size{0};
+    size_t m_hit_count{0};
+    size_t m_miss_count{0};
+};
+
+} // namespace sgl
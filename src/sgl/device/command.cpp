@@ -8,6 +8,7 @@
 #include "sgl/device/resource.h"
 #include "sgl/device/query.h"
 #include "sgl/device/pipeline.h"
+#include "sgl/device/shader.h"
 #include "sgl/device/raytracing.h"
 #include "sgl/device/shader_object.h"
 #include "sgl/device/cuda_utils.h"
@@ -22,6 +23,9 @@
 
 #include "sgl/math/vector.h"
 
+#include <algorithm>
+#include <mutex>
+
 namespace sgl {
 
 namespace detail {
@@ -55,6 +59,20 @@ namespace detail {
             .startIndexLocation = draw_args.start_index_location,
         };
     }
+
+    /// Pipelines with deferred target compilation are compiled by slang-rhi when they are bound and when the
+    /// command encoder is finished. Slang sessions are not thread safe, so until the pipeline is compiled,
+    /// binding takes the session lock and registers the pipeline with the encoder so that its session can be
+    /// locked again in \c CommandEncoder::finish.
+    template<typename PipelineType>
+    inline std::unique_lock<std::recursive_mutex>
+    lock_deferred_session(CommandEncoder* command_encoder, PipelineType* pipeline)
+    {
+        if (!pipeline->desc().defer_target_compilation || pipeline->_is_target_compiled())
+            return {};
+        command_encoder->_track_deferred_pipeline(pipeline);
+        return pipeline->desc().program->session()->_lock();
+    }
 } // namespace detail
 
 // ----------------------------------------------------------------------------
@@ -97,6 +115,7 @@ ShaderObject* RenderPassEncoder::bind_pipeline(RenderPipeline* pipeline)
 {
     SGL_CHECK_NOT_NULL(pipeline);
 
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     rhi::IShaderObject* rhi_root_object = m_rhi_render_pass_encoder->bindPipeline(pipeline->rhi_pipeline());
     ShaderObject* root_object = m_command_encoder->_get_root_object(rhi_root_object);
     if (m_command_encoder->device()->debug_printer())
@@ -109,6 +128,7 @@ void RenderPassEncoder::bind_pipeline(RenderPipeline* pipeline, ShaderObject* ro
     SGL_CHECK_NOT_NULL(pipeline);
     SGL_CHECK_NOT_NULL(root_object);
 
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     m_rhi_render_pass_encoder->bindPipeline(pipeline->rhi_pipeline(), root_object->rhi_shader_object());
 }
 
@@ -180,6 +200,7 @@ ShaderObject* ComputePassEncoder::bind_pipeline(ComputePipeline* pipeline)
     SGL_CHECK_NOT_NULL(pipeline);
 
     m_thread_group_size = pipeline->thread_group_size();
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     rhi::IShaderObject* rhi_root_object = m_rhi_compute_pass_encoder->bindPipeline(pipeline->rhi_pipeline());
     ShaderObject* root_object = m_command_encoder->_get_root_object(rhi_root_object);
     if (m_command_encoder->device()->debug_printer())
@@ -193,6 +214,7 @@ void ComputePassEncoder::bind_pipeline(ComputePipeline* pipeline, ShaderObject*
     SGL_CHECK_NOT_NULL(root_object);
 
     m_thread_group_size = pipeline->thread_group_size();
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     m_rhi_compute_pass_encoder->bindPipeline(pipeline->rhi_pipeline(), root_object->rhi_shader_object());
 }
 
@@ -230,6 +252,7 @@ ShaderObject* RayTracingPassEncoder::bind_pipeline(RayTracingPipeline* pipeline,
 {
     SGL_CHECK_NOT_NULL(pipeline);
 
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     rhi::IShaderObject* rhi_root_object
         = m_rhi_ray_tracing_pass_encoder->bindPipeline(pipeline->rhi_pipeline(), shader_table->rhi_shader_table());
     ShaderObject* root_object = m_command_encoder->_get_root_object(rhi_root_object);
@@ -248,6 +271,7 @@ void RayTracingPassEncoder::bind_pipeline(
     SGL_CHECK_NOT_NULL(shader_table);
     SGL_CHECK_NOT_NULL(root_object);
 
+    auto lock = detail::lock_deferred_session(m_command_encoder, pipeline);
     m_rhi_ray_tracing_pass_encoder
         ->bindPipeline(pipeline->rhi_pipeline(), shader_table->rhi_shader_table(), root_object->rhi_shader_object());
 }
@@ -272,6 +296,13 @@ CommandEncoder::CommandEncoder(ref<Device> device, Slang::ComPtr<rhi::ICommandEn
     , m_rhi_command_encoder(std::move(rhi_command_encoder))
     , m_open(true)
 {
+    m_id = m_device->_register_command_encoder();
+}
+
+CommandEncoder::~CommandEncoder()
+{
+    if (m_id != 0)
+        m_device->_unregister_command_encoder(m_id);
 }
 
 ref<RenderPassEncoder> CommandEncoder::begin_render_pass(const RenderPassDesc& desc)
@@ -348,6 +379,12 @@ ShaderObject* CommandEncoder::_get_root_object(rhi::IShaderObject* rhi_shader_ob
     return m_root_object.get();
 }
 
+void CommandEncoder::_track_deferred_pipeline(Pipeline* pipeline)
+{
+    if (std::find(m_deferred_pipelines.begin(), m_deferred_pipelines.end(), pipeline) == m_deferred_pipelines.end())
+        m_deferred_pipelines.push_back(ref(pipeline));
+}
+
 void CommandEncoder::copy_buffer(
     Buffer* dst,
     DeviceOffset dst_offset,
@@ -880,9 +917,31 @@ void CommandEncoder::write_timestamp(QueryPool* query_pool, uint32_t index)
 ref<CommandBuffer> CommandEncoder::finish()
 {
     SGL_CHECK(m_open, "Command encoder is finished");
+
+    // slang-rhi resolves pipelines with deferred target compilation when finishing.
+    // Lock the sessions of all such pipelines that were not compiled yet (in a fixed order to avoid lock order
+    // inversion). Encoders only binding compiled pipelines don't lock anything.
+    std::vector<SlangSession*> sessions;
+    for (const ref<Pipeline>& pipeline : m_deferred_pipelines)
+        sessions.push_back(pipeline->_program()->session());
+    std::sort(sessions.begin(), sessions.end());
+    sessions.erase(std::unique(sessions.begin(), sessions.end()), sessions.end());
+    std::vector<std::unique_lock<std::recursive_mutex>> session_locks;
+    session_locks.reserve(sessions.size());
+    for (SlangSession* session : sessions)
+        session_locks.push_back(session->_lock());
+
     Slang::ComPtr<rhi::ICommandBuffer> rhi_command_buffer;
     SLANG_RHI_CALL(m_rhi_command_encoder->finish(rhi_command_buffer.writeRef()));
-    ref<CommandBuffer> command_buffer = make_ref<CommandBuffer>(m_device, rhi_command_buffer);
+
+    // Programs with specialization parameters may be compiled again for other specializations.
+    for (const ref<Pipeline>& pipeline : m_deferred_pipelines)
+        if (!pipeline->_program()->_is_specializable())
+            pipeline->_set_target_compiled();
+    session_locks.clear();
+    m_deferred_pipelines.clear();
+    ref<CommandBuffer> command_buffer = make_ref<CommandBuffer>(m_device, rhi_command_buffer, m_id);
+    m_id = 0;
     m_open = false;
     return command_buffer;
 }
@@ -908,13 +967,22 @@ std::string CommandEncoder::to_string() const
 // CommandBuffer
 // ----------------------------------------------------------------------------
 
-CommandBuffer::CommandBuffer(ref<Device> device, Slang::ComPtr<rhi::ICommandBuffer> command_buffer)
+CommandBuffer::CommandBuffer(
+    ref<Device> device,
+    Slang::ComPtr<rhi::ICommandBuffer> command_buffer,
+    uint64_t command_encoder_id
+)
     : DeviceChild(std::move(device))
     , m_rhi_command_buffer(std::move(command_buffer))
+    , m_command_encoder_id(command_encoder_id)
 {
 }
 
-CommandBuffer::~CommandBuffer() { }
+CommandBuffer::~CommandBuffer()
+{
+    if (m_command_encoder_id != 0)
+        m_device->_unregister_command_encoder(m_command_encoder_id);
+}
 
 std::string CommandBuffer::to_string() const
 {
@@ -150,6 +150,7 @@ class SGL_API CommandEncoder : public DeviceChild {
     SGL_OBJECT(CommandEncoder)
 public:
     CommandEncoder(ref<Device> device, Slang::ComPtr<rhi::ICommandEncoder> rhi_command_encoder);
+    ~CommandEncoder();
 
     virtual void _release_rhi_resources() override { m_rhi_command_encoder.setNull(); }
 
@@ -159,6 +160,10 @@ public:
 
     ShaderObject* _get_root_object(rhi::IShaderObject* rhi_shader_object);
 
+    /// Register a bound pipeline with deferred target compilation that is not compiled yet
+    /// (its session is locked in \c finish).
+    void _track_deferred_pipeline(Pipeline* pipeline);
+
     /**
      * \brief Copy a buffer region.
      *
@@ -432,16 +437,24 @@ private:
 
     bool m_open{false};
 
+    /// Id registered with the device, handed over to the command buffer on \c finish.
+    uint64_t m_id{0};
+
     ref<RenderPassEncoder> m_render_pass_encoder;
     ref<ComputePassEncoder> m_compute_pass_encoder;
     ref<RayTracingPassEncoder> m_ray_tracing_pass_encoder;
     ref<ShaderObject> m_root_object;
+    std::vector<ref<Pipeline>> m_deferred_pipelines;
 };
 
 class SGL_API CommandBuffer : public DeviceChild {
     SGL_OBJECT(CommandBuffer)
 public:
-    CommandBuffer(ref<Device> device, Slang::ComPtr<rhi::ICommandBuffer> rhi_command_buffer);
+    CommandBuffer(
+        ref<Device> device,
+        Slang::ComPtr<rhi::ICommandBuffer> rhi_command_buffer,
+        uint64_t command_encoder_id = 0
+    );
     ~CommandBuffer();
 
     virtual void _release_rhi_resources() override { m_rhi_command_buffer.setNull(); }
@@ -455,6 +468,9 @@ private:
 
     std::vector<ref<cuda::InteropBuffer>> m_cuda_interop_buffers;
 
+    /// Id of the command encoder that recorded this command buffer, 0 once submitted.
+    uint64_t m_command_encoder_id{0};
+
     friend class Device;
 };
 
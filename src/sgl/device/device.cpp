@@ -30,6 +30,7 @@
 #include "sgl/core/error.h"
 #include "sgl/core/window.h"
 #include "sgl/core/string.h"
+#include "sgl/core/thread.h"
 
 #if SGL_HAS_D3D12
 #include <dxgi.h>
@@ -37,6 +38,7 @@
 #include <comdef.h>
 #endif
 
+#include <map>
 #include <mutex>
 
 namespace sgl {
@@ -327,6 +329,9 @@ Device::Device(const DeviceDesc& desc)
     // Create global fence to synchronize command submission.
     m_global_fence = create_fence({.shared = m_desc.enable_cuda_interop});
 
+    // Create the buffer pool up front, it is shared by all threads using the device.
+    m_buffer_pool = make_ref<BufferPool>(this);
+
     // Finalize CUDA interop.
     if (m_desc.enable_cuda_interop) {
 
@@ -399,6 +404,19 @@ ShaderCacheStats Device::shader_cache_stats() const
     }
 }
 
+BufferPool* Device::buffer_pool()
+{
+    return m_buffer_pool;
+}
+
+BufferPoolStats Device::buffer_pool_stats() const
+{
+    if (m_buffer_pool)
+        return m_buffer_pool->stats();
+    else
+        return {};
+}
+
 bool Device::has_feature(Feature feature) const
 {
     return m_rhi_device->hasFeature(static_cast<rhi::Feature>(feature));
@@ -438,6 +456,7 @@ void Device::close()
     m_device_close_callbacks.clear();
 
     m_blitter.reset();
+    m_buffer_pool.reset();
     m_debug_printer.reset();
 
     m_global_fence.reset();
@@ -733,6 +752,55 @@ ref<ComputePipeline> Device::create_compute_pipeline(ComputePipelineDesc desc)
     return make_ref<ComputePipeline>(ref<Device>(this), std::move(desc));
 }
 
+std::vector<ref<ComputePipeline>> Device::create_compute_pipelines(std::vector<ComputePipelineDesc> descs)
+{
+    if (descs.empty())
+        return {};
+
+    for (const ComputePipelineDesc& desc : descs)
+        SGL_CHECK_NOT_NULL(desc.program);
+
+    // Generate the target code of all programs up front. This enters the Slang session, which is not thread safe,
+    // so it is done serially (holding the session lock). Slang keeps the code with the linked program, so creating
+    // the pipelines afterwards only reads it back and spends its time in slang-rhi and the driver, in parallel.
+    // Pipelines of one program share the cached code, so they are created by the same task.
+    std::map<ShaderProgram*, std::vector<size_t>> program_descs;
+    std::vector<size_t> deferred;
+    for (size_t i = 0; i < descs.size(); ++i) {
+        if (descs[i].defer_target_compilation)
+            deferred.push_back(i);
+        else
+            program_descs[descs[i].program].push_back(i);
+    }
+    std::vector<const std::vector<size_t>*> groups;
+    for (const auto& [program, indices] : program_descs) {
+        program->generate_target_code();
+        groups.push_back(&indices);
+    }
+
+    std::vector<Slang::ComPtr<rhi::IComputePipeline>> rhi_pipelines(descs.size());
+    thread::parallel_for(
+        thread::blocked_range<size_t>(0, groups.size()),
+        [&](const thread::blocked_range<size_t>& range)
+        {
+            for (size_t group = range.begin(); group != range.end(); ++group)
+                for (size_t i : *groups[group])
+                    rhi_pipelines[i] = ComputePipeline::_create_rhi_pipeline(this, descs[i], false);
+        }
+    );
+
+    // Pipelines with deferred target compilation don't compile anything here.
+    for (size_t i : deferred)
+        rhi_pipelines[i] = ComputePipeline::_create_rhi_pipeline(this, descs[i]);
+
+    // Registering pipelines with their programs is not thread safe, so wrap them serially.
+    std::vector<ref<ComputePipeline>> pipelines;
+    pipelines.reserve(descs.size());
+    for (size_t i = 0; i < descs.size(); ++i)
+        pipelines.push_back(make_ref<ComputePipeline>(ref<Device>(this), std::move(descs[i]), rhi_pipelines[i]));
+    return pipelines;
+}
+
 ref<RenderPipeline> Device::create_render_pipeline(RenderPipelineDesc desc)
 {
     return make_ref<RenderPipeline>(ref<Device>(this), std::move(desc));
@@ -782,9 +850,10 @@ uint64_t Device::submit_command_buffers(
         "Native handle supplied for CUDA stream is not of type CUstream."
     );
 
-    // Update hot reload system if created.
-    // TODO(slang-rhi) need to make sure this is not too expensive.
-    if (m_hot_reload)
+    // Update hot reload system if created and file changes have been detected.
+    // Changes are detected on the file system watcher thread, so this is only an atomic load
+    // unless shaders have been edited, in which case the affected sessions are recreated here.
+    if (m_hot_reload && m_hot_reload->has_pending_changes())
         m_hot_reload->update();
 
     // Pointer to CUDA stream
@@ -815,6 +884,11 @@ uint64_t Device::submit_command_buffers(
     // CUDA interop allocations.
     bool needs_cuda_sync = cuda_stream.is_valid();
 
+    // Reused pool buffers are cleared ahead of the submitted commands, which may use them.
+    ref<CommandBuffer> clear_command_buffer = m_buffer_pool ? m_buffer_pool->_record_clears() : nullptr;
+    if (clear_command_buffer)
+        rhi_command_buffers.push_back(clear_command_buffer->rhi_command_buffer());
+
     for (CommandBuffer* command_buffer : command_buffers) {
         SGL_CHECK_NOT_NULL(command_buffer);
         rhi_command_buffers.push_back(command_buffer->rhi_command_buffer());
@@ -875,6 +949,16 @@ uint64_t Device::submit_command_buffers(
     };
     SLANG_RHI_CALL(m_rhi_graphics_queue->submit(rhi_submit_desc));
 
+    // The commands are now covered by the submit id, see BufferPool.
+    for (CommandBuffer* command_buffer : command_buffers) {
+        _unregister_command_encoder(command_buffer->m_command_encoder_id);
+        command_buffer->m_command_encoder_id = 0;
+    }
+    if (clear_command_buffer) {
+        _unregister_command_encoder(clear_command_buffer->m_command_encoder_id);
+        clear_command_buffer->m_command_encoder_id = 0;
+    }
+
     // Handle CUDA interop.
     if (m_supports_cuda_interop && needs_cuda_sync) {
         sync_to_device(cuda_stream_ptr);
@@ -896,6 +980,11 @@ uint64_t Device::submit_command_buffer(CommandBuffer* command_buffer, CommandQue
     return submit_command_buffers(command_buffers, {}, {}, {}, {}, queue, cuda_stream);
 }
 
+uint64_t Device::last_submit_id() const
+{
+    return m_global_fence->signaled_value();
+}
+
 bool Device::is_submit_finished(uint64_t id)
 {
     return id <= m_global_fence->current_value();
@@ -1248,6 +1337,32 @@ void Device::_unregister_device_child(DeviceChild* device_child)
     m_device_children.erase(device_child);
 }
 
+uint64_t Device::_register_command_encoder()
+{
+    std::lock_guard lock(m_command_encoders_mutex);
+    uint64_t id = ++m_last_command_encoder_id;
+    m_pending_command_encoders.insert(id);
+    return id;
+}
+
+void Device::_unregister_command_encoder(uint64_t id)
+{
+    std::lock_guard lock(m_command_encoders_mutex);
+    m_pending_command_encoders.erase(id);
+}
+
+uint64_t Device::_last_command_encoder_id() const
+{
+    std::lock_guard lock(m_command_encoders_mutex);
+    return m_last_command_encoder_id;
+}
+
+uint64_t Device::_oldest_pending_command_encoder_id() const
+{
+    std::lock_guard lock(m_command_encoders_mutex);
+    return m_pending_command_encoders.empty() ? UINT64_MAX : *m_pending_command_encoders.begin();
+}
+
 std::array<NativeHandle, 3> get_cuda_current_context_native_handles()
 {
     std::array<NativeHandle, 3> handles;
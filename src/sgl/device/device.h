@@ -8,6 +8,7 @@
 #include "sgl/device/resource.h"
 #include "sgl/device/shader.h"
 #include "sgl/device/raytracing.h"
+#include "sgl/device/buffer_pool.h"
 
 #include "sgl/core/fwd.h"
 #include "sgl/core/config.h"
@@ -21,7 +22,9 @@
 
 #include <array>
 #include <filesystem>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -207,7 +210,12 @@ struct ShaderCacheStats {
 };
 
 /// Event data for hot reload hook.
-struct ShaderHotReloadEvent { };
+struct ShaderHotReloadEvent {
+    /// Sessions that have been recreated.
+    std::vector<ref<SlangSession>> sessions;
+    /// Changed files that triggered the reload. Empty if the reload was forced.
+    std::vector<std::filesystem::path> changed_files;
+};
 using ShaderHotReloadCallback = std::function<void(const ShaderHotReloadEvent&)>;
 
 
@@ -237,6 +245,12 @@ public:
     /// Shader cache statistics.
     ShaderCacheStats shader_cache_stats() const;
 
+    /// Pool for short lived buffers, such as function call outputs.
+    BufferPool* buffer_pool();
+
+    /// Buffer pool statistics.
+    BufferPoolStats buffer_pool_stats() const;
+
     /// The highest shader model supported by the device.
     ShaderModel supported_shader_model() const { return m_supported_shader_model; }
 
@@ -486,6 +500,12 @@ public:
 
     ref<ComputePipeline> create_compute_pipeline(ComputePipelineDesc desc);
 
+    /// Create a batch of compute pipelines.
+    /// Slang sessions are not thread safe, so the target code of all programs is first generated serially while
+    /// holding the session lock. The rhi pipelines (including the driver compile) are then created in parallel on
+    /// the thread pool from the generated code, without holding the lock.
+    std::vector<ref<ComputePipeline>> create_compute_pipelines(std::vector<ComputePipelineDesc> descs);
+
     ref<RenderPipeline> create_render_pipeline(RenderPipelineDesc desc);
 
     ref<RayTracingPipeline> create_ray_tracing_pipeline(RayTracingPipelineDesc desc);
@@ -544,6 +564,9 @@ public:
         NativeHandle cuda_stream = {}
     );
 
+    /// ID of the last submission.
+    uint64_t last_submit_id() const;
+
     /**
      * \brief Check if a submission is finished executing.
      *
@@ -714,15 +737,27 @@ public:
     HotReload* _hot_reload() { return m_hot_reload; }
 
     /// Called by hot reload system after reload occurs, to trigger the hooks.
-    void _on_hot_reload()
+    void _on_hot_reload(const ShaderHotReloadEvent& event)
     {
         for (auto& hook : m_shader_hot_reload_callbacks)
-            hook({});
+            hook(event);
     }
 
     void _register_device_child(DeviceChild* device_child);
     void _unregister_device_child(DeviceChild* device_child);
 
+    /// Register a new command encoder and return its id.
+    /// Ids are increasing, the encoder stays pending until its command buffer is submitted or released.
+    uint64_t _register_command_encoder();
+    void _unregister_command_encoder(uint64_t id);
+
+    /// Id of the most recently registered command encoder.
+    uint64_t _last_command_encoder_id() const;
+
+    /// Id of the oldest pending command encoder, or \c UINT64_MAX if there is none.
+    /// Commands recorded by encoders with a lower id have been submitted (or dropped).
+    uint64_t _oldest_pending_command_encoder_id() const;
+
 private:
     DeviceDesc m_desc;
     DeviceInfo m_info;
@@ -755,6 +790,7 @@ private:
     std::vector<DeviceCloseCallback> m_device_close_callbacks;
 
     ref<Blitter> m_blitter;
+    ref<BufferPool> m_buffer_pool;
     ref<HotReload> m_hot_reload;
 
     bool m_supports_cuda_interop{false};
@@ -763,6 +799,10 @@ private:
 
     std::mutex m_device_children_mutex;
     std::unordered_set<DeviceChild*> m_device_children;
+
+    mutable std::mutex m_command_encoders_mutex;
+    uint64_t m_last_command_encoder_id{0};
+    std::set<uint64_t> m_pending_command_encoders;
 };
 
 /// Gets the device and context handles for the current CUDA context. Use
@@ -137,6 +137,11 @@ class InputLayout;
 
 class Blitter;
 
+// buffer_pool.h
+
+struct BufferPoolStats;
+class BufferPool;
+
 // texture_loader.h
 
 class TextureLoader;
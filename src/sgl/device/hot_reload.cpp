@@ -8,6 +8,32 @@
 
 namespace sgl {
 
+namespace detail {
+    std::vector<std::filesystem::path> get_module_dependencies(slang::IModule* slang_module)
+    {
+        std::vector<std::filesystem::path> dependencies;
+        SlangInt32 dependency_count = slang_module->getDependencyFileCount();
+        for (SlangInt32 dependency_index = 0; dependency_index < dependency_count; dependency_index++) {
+            // Get the dependency as an FS path and verify it is absolute.
+            const char* path = slang_module->getDependencyFilePath(dependency_index);
+            if (!path)
+                continue;
+            std::filesystem::path abs_path = path;
+            if (!abs_path.is_absolute()) {
+                // IModule::getDependencyFilePath can return relative file paths for shaders
+                // that are in the current working directory.
+                // If the path is not absolute, we also try to resolve it against cwd to turn it into
+                // absolute path. The returned path can also be a non-file, e.g. for string modules.
+                if (!std::filesystem::exists(abs_path))
+                    continue;
+                abs_path = std::filesystem::absolute(abs_path);
+            }
+            dependencies.push_back(abs_path.lexically_normal().make_preferred());
+        }
+        return dependencies;
+    }
+} // namespace detail
+
 HotReload::HotReload(ref<Device> device)
     : m_device(device.get())
 {
@@ -30,18 +56,36 @@ void HotReload::update()
 
 void HotReload::on_file_system_event(std::span<FileSystemWatchEvent> events)
 {
-    // Simple check to see if any events involved .slang files.
-    auto fn_check = [](const FileSystemWatchEvent& e)
-    {
-        return platform::has_extension(e.path, "slang");
-    };
-    bool has_slang_files = std::find_if(events.begin(), events.end(), fn_check) != events.end();
-    if (!has_slang_files)
+    if (!m_auto_detect_changes)
         return;
 
-    // If slang files detected, recreate all existing sessions
-    if (m_auto_detect_changes)
-        recreate_all_sessions();
+    // Find sessions that depend on any of the changed .slang files.
+    // Adding or removing a file can change how imports are resolved, so these affect
+    // all sessions with a dependency in the same directory.
+    std::set<SlangSession*> sessions;
+    std::vector<std::filesystem::path> changed_files;
+    for (const FileSystemWatchEvent& event : events) {
+        if (!platform::has_extension(event.path, "slang"))
+            continue;
+        std::filesystem::path path = event.absolute_path.lexically_normal().make_preferred();
+        changed_files.push_back(path);
+        for (const auto& [session, dependencies] : m_session_dependencies) {
+            if (event.change == FileSystemWatcherChange::modified) {
+                if (dependencies.contains(path))
+                    sessions.insert(session);
+            } else {
+                for (const std::filesystem::path& dependency : dependencies) {
+                    if (dependency.parent_path() == path.parent_path()) {
+                        sessions.insert(session);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (!sessions.empty())
+        recreate_sessions(sessions, std::move(changed_files));
 }
 
 
@@ -53,6 +97,7 @@ void HotReload::_register_slang_session(SlangSession* session)
 void HotReload::_unregister_slang_session(SlangSession* session)
 {
     m_all_slang_sessions.erase(session);
+    m_session_dependencies.erase(session);
 }
 
 void HotReload::_on_session_modules_changed(SlangSession* session)
@@ -71,8 +116,29 @@ void HotReload::set_auto_detect_delay(uint32_t delay_ms)
 
 void HotReload::recreate_all_sessions()
 {
-    // Notify reflection system to clear all reflection data
-    detail::invalidate_all_reflection_data();
+    recreate_sessions(m_all_slang_sessions, {});
+}
+
+void HotReload::recreate_sessions(
+    const std::set<SlangSession*>& sessions,
+    std::vector<std::filesystem::path> changed_files
+)
+{
+    // Notify reflection system to clear reflection data owned by the recreated sessions.
+    // Reflection data with an unknown owner is always cleared.
+    detail::invalidate_reflection_data(
+        [&](const Object* owner)
+        {
+            SlangSession* session = nullptr;
+            if (auto module = dynamic_cast<const SlangModule*>(owner))
+                session = module->session();
+            else if (auto entry_point = dynamic_cast<const SlangEntryPoint*>(owner))
+                session = entry_point->module()->session();
+            else if (auto program = dynamic_cast<const ShaderProgram*>(owner))
+                session = program->session();
+            return !session || sessions.contains(session);
+        }
+    );
 
     // Iterate over sessions and build each one. This is in a try/catch
     // statement as we don't want programs to except as a result
@@ -80,7 +146,7 @@ void HotReload::recreate_all_sessions()
     // logged and application carry on as usual.
     try {
         m_last_build_failed = false;
-        for (SlangSession* session : m_all_slang_sessions)
+        for (SlangSession* session : sessions)
             session->recreate_session();
     } catch (SlangCompileError& compile_error) {
         log_error("Hot reload failed due to compile error");
@@ -96,41 +162,31 @@ void HotReload::recreate_all_sessions()
     m_has_reloaded = true;
 
     // Notify device so it can notify hooks.
-    m_device->_on_hot_reload();
+    ShaderHotReloadEvent event{.changed_files = std::move(changed_files)};
+    for (SlangSession* session : sessions)
+        event.sessions.push_back(ref(session));
+    m_device->_on_hot_reload(event);
 }
 
 void HotReload::update_watched_paths_for_session(SlangSession* session)
 {
-    // Iterate over all the dependencies of all modules in the session.
+    // Collect the dependencies of all modules in the session.
+    std::set<std::filesystem::path>& dependencies = m_session_dependencies[session];
+    dependencies.clear();
     slang::ISession* slang_session = session->get_slang_session();
     SlangInt module_count = slang_session->getLoadedModuleCount();
     for (SlangInt module_index = 0; module_index < module_count; module_index++) {
         slang::IModule* slang_module = slang_session->getLoadedModule(module_index);
-        SlangInt32 dependency_count = slang_module->getDependencyFileCount();
-        for (SlangInt32 dependency_index = 0; dependency_index < dependency_count; dependency_index++) {
-            {
-                // Get the dependency as an FS path, verify it is absolute and turn into directory path.
-                const char* path = slang_module->getDependencyFilePath(dependency_index);
-                if (path) {
-                    std::filesystem::path abs_path = path;
-                    if (!abs_path.is_absolute()) {
-                        // IModule::getDependencyFilePath can return relative file paths for shaders
-                        // that are in the current working directory.
-                        // If the path is not absolute, we also try to resolve it against cwd to turn it into
-                        // absolute path. The returned path can also be a non-file, e.g. for string modules.
-                        if (!std::filesystem::exists(abs_path))
-                            continue;
-                        abs_path = std::filesystem::absolute(abs_path);
-                    }
-                    abs_path = abs_path.parent_path().make_preferred();
+        for (std::filesystem::path& path : detail::get_module_dependencies(slang_module))
+            dependencies.insert(std::move(path));
+    }
 
-                    // If not already monitoring this path, add a watch for it.
-                    if (!m_watched_paths.contains(abs_path)) {
-                        m_file_system_watcher->add_watch({.directory = abs_path});
-                        m_watched_paths.insert(abs_path);
-                    }
-                }
-            }
+    // If not already monitoring the directory of a dependency, add a watch for it.
+    for (const std::filesystem::path& path : dependencies) {
+        std::filesystem::path directory = path.parent_path();
+        if (!m_watched_paths.contains(directory)) {
+            m_file_system_watcher->add_watch({.directory = directory});
+            m_watched_paths.insert(directory);
         }
     }
 }
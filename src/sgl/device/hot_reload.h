@@ -10,10 +10,12 @@
 #include "sgl/core/fwd.h"
 #include "sgl/core/object.h"
 #include "sgl/core/enum.h"
+#include "sgl/core/file_system_watcher.h"
 
 #include <slang.h>
 
 #include <exception>
+#include <filesystem>
 #include <map>
 #include <set>
 #include <span>
@@ -22,8 +24,15 @@
 
 namespace sgl {
 
+namespace detail {
+    /// Get the absolute paths of all files a slang module depends on.
+    /// Dependencies that are not files (e.g. modules created from strings) are skipped.
+    SGL_API std::vector<std::filesystem::path> get_module_dependencies(slang::IModule* slang_module);
+} // namespace detail
+
 /// Shader hot reload management, detects when relevant slang files
 /// have been editor and triggers session recreates as necessary.
+/// Only sessions that depend on a changed file are recreated.
 class SGL_API HotReload : public Object {
     SGL_OBJECT(HotReload)
 public:
@@ -34,8 +43,13 @@ public:
     void recreate_all_sessions();
 
     /// Updates internal file system monitor for change detection.
+    /// Sessions affected by file changes are recreated here.
     void update();
 
+    /// True if file changes have been detected that have not been processed by \c update() yet.
+    /// Only performs an atomic load, so it can be checked on hot paths.
+    bool has_pending_changes() const { return m_file_system_watcher->has_queued_events(); }
+
     // Enable/disable auto rebuild in response to file system events.
     bool auto_detect_changes() const { return m_auto_detect_changes; }
     void set_auto_detect_changes(bool val) { m_auto_detect_changes = val; }
@@ -64,12 +78,17 @@ private:
     void on_file_system_event(std::span<FileSystemWatchEvent> events);
     void update_watched_paths_for_session(SlangSession* session);
 
+    /// Recreate the given sessions. \c changed_files is empty if the recreate was forced.
+    void recreate_sessions(const std::set<SlangSession*>& sessions, std::vector<std::filesystem::path> changed_files);
+
     Device* m_device;
     bool m_auto_detect_changes{true};
     ref<FileSystemWatcher> m_file_system_watcher;
     std::set<SlangSession*> m_all_slang_sessions;
     bool m_last_build_failed{false};
     std::set<std::filesystem::path> m_watched_paths;
+    /// Files each session depends on.
+    std::map<SlangSession*, std::set<std::filesystem::path>> m_session_dependencies;
     bool m_has_reloaded;
 };
 
@@ -13,6 +13,7 @@
 
 #include "sgl/math/vector.h"
 
+#include <mutex>
 
 namespace sgl {
 
@@ -34,6 +35,7 @@ Pipeline::~Pipeline()
 
 void Pipeline::notify_program_reloaded()
 {
+    m_target_compiled = false;
     recreate();
 }
 
@@ -48,16 +50,38 @@ ComputePipeline::ComputePipeline(ref<Device> device, ComputePipelineDesc desc)
     recreate();
 }
 
-void ComputePipeline::recreate()
+ComputePipeline::ComputePipeline(
+    ref<Device> device,
+    ComputePipelineDesc desc,
+    Slang::ComPtr<rhi::IComputePipeline> rhi_pipeline
+)
+    : Pipeline(std::move(device), desc.program)
+    , m_desc(std::move(desc))
+    , m_rhi_pipeline(std::move(rhi_pipeline))
+{
+    m_thread_group_size = m_desc.program->layout()->get_entry_point_by_index(0)->compute_thread_group_size();
+}
+
+Slang::ComPtr<rhi::IComputePipeline>
+ComputePipeline::_create_rhi_pipeline(Device* device, const ComputePipelineDesc& desc, bool lock_session)
 {
     rhi::ComputePipelineDesc rhi_desc{
-        .program = m_desc.program->rhi_shader_program(),
-        .deferTargetCompilation = m_desc.defer_target_compilation,
-        .label = m_desc.label.empty() ? nullptr : m_desc.label.c_str(),
+        .program = desc.program->rhi_shader_program(),
+        .deferTargetCompilation = desc.defer_target_compilation,
+        .label = desc.label.empty() ? nullptr : desc.label.c_str(),
     };
-    SLANG_RHI_CALL(
-        m_device->rhi_device()->createComputePipeline(rhi_desc, (rhi::IComputePipeline**)m_rhi_pipeline.writeRef())
-    );
+    Slang::ComPtr<rhi::IComputePipeline> rhi_pipeline;
+    // Creating the pipeline compiles target code through the program's Slang session.
+    std::unique_lock<std::recursive_mutex> lock;
+    if (lock_session)
+        lock = desc.program->session()->_lock();
+    SLANG_RHI_CALL(device->rhi_device()->createComputePipeline(rhi_desc, rhi_pipeline.writeRef()));
+    return rhi_pipeline;
+}
+
+void ComputePipeline::recreate()
+{
+    m_rhi_pipeline = _create_rhi_pipeline(m_device, m_desc);
     m_thread_group_size = m_desc.program->layout()->get_entry_point_by_index(0)->compute_thread_group_size();
 }
 
@@ -172,6 +196,7 @@ void RenderPipeline::recreate()
         .label = m_desc.label.empty() ? nullptr : m_desc.label.c_str(),
     };
 
+    auto lock = m_desc.program->session()->_lock();
     SLANG_RHI_CALL(
         m_device->rhi_device()->createRenderPipeline(rhi_desc, (rhi::IRenderPipeline**)m_rhi_pipeline.writeRef())
     );
@@ -237,6 +262,7 @@ void RayTracingPipeline::recreate()
         .deferTargetCompilation = m_desc.defer_target_compilation,
         .label = m_desc.label.empty() ? nullptr : m_desc.label.c_str(),
     };
+    auto lock = m_desc.program->session()->_lock();
     SLANG_RHI_CALL(m_device->rhi_device()
                        ->createRayTracingPipeline(rhi_desc, (rhi::IRayTracingPipeline**)m_rhi_pipeline.writeRef()));
 }
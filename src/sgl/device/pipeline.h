@@ -15,6 +15,7 @@
 
 #include <slang-rhi.h>
 
+#include <atomic>
 #include <map>
 #include <set>
 
@@ -30,6 +31,13 @@ public:
 
     void notify_program_reloaded();
 
+    ShaderProgram* _program() const { return m_program; }
+
+    /// True once slang-rhi compiled the target code of a pipeline with deferred target compilation.
+    /// Until then, binding the pipeline needs the session lock (see \c CommandEncoder::finish).
+    bool _is_target_compiled() const { return m_target_compiled.load(std::memory_order_acquire); }
+    void _set_target_compiled() { m_target_compiled.store(true, std::memory_order_release); }
+
 protected:
     virtual void recreate() = 0;
 
@@ -39,6 +47,8 @@ private:
     /// the with program. However due to order of destruction
     /// this still needs to hold a strong reference.
     ref<ShaderProgram> m_program;
+
+    std::atomic<bool> m_target_compiled{false};
 };
 
 struct ComputePipelineDesc {
@@ -52,6 +62,9 @@ class SGL_API ComputePipeline : public Pipeline {
 public:
     ComputePipeline(ref<Device> device, ComputePipelineDesc desc);
 
+    /// Create from an already created rhi pipeline (see \c Device::create_compute_pipelines).
+    ComputePipeline(ref<Device> device, ComputePipelineDesc desc, Slang::ComPtr<rhi::IComputePipeline> rhi_pipeline);
+
     virtual void _release_rhi_resources() override { m_rhi_pipeline.setNull(); }
 
     const ComputePipelineDesc& desc() const { return m_desc; }
@@ -67,6 +80,12 @@ public:
 
     std::string to_string() const override;
 
+    /// Create the rhi pipeline for a descriptor.
+    /// \param lock_session Hold the session lock while creating the pipeline. Only safe to disable if the
+    /// target code of the program was already generated (see \c ShaderProgram::generate_target_code).
+    static Slang::ComPtr<rhi::IComputePipeline>
+    _create_rhi_pipeline(Device* device, const ComputePipelineDesc& desc, bool lock_session = true);
+
 protected:
     virtual void recreate() override;
 
@@ -3,6 +3,7 @@
 #include "raytracing.h"
 
 #include "sgl/device/device.h"
+#include "sgl/device/command.h"
 #include "sgl/device/helpers.h"
 #include "sgl/device/shader.h"
 
@@ -11,6 +12,8 @@
 
 #include <slang-rhi/acceleration-structure-utils.h>
 
+#include <algorithm>
+
 namespace sgl {
 
 AccelerationStructureBuildDescConverter::AccelerationStructureBuildDescConverter(
@@ -170,50 +173,172 @@ AccelerationStructureInstanceList::~AccelerationStructureInstanceList() { }
 
 void AccelerationStructureInstanceList::resize(size_t size)
 {
+    size_t old_size = m_instances.size();
     m_instances.resize(size);
-    m_dirty = true;
+    if (size > old_size)
+        mark_dirty(old_size, size);
 }
 
 void AccelerationStructureInstanceList::write(size_t index, const AccelerationStructureInstanceDesc& instance)
 {
+    SGL_CHECK(index < m_instances.size(), "'index' ({}) out of range ({})", index, m_instances.size());
     m_instances[index] = instance;
-    m_dirty = true;
+    mark_dirty(index, index + 1);
 }
 
 void AccelerationStructureInstanceList::write(size_t index, std::span<AccelerationStructureInstanceDesc> instances)
 {
+    SGL_CHECK(
+        index + instances.size() <= m_instances.size(),
+        "'index' ({}) and instance count ({}) out of range ({})",
+        index,
+        instances.size(),
+        m_instances.size()
+    );
     std::copy(instances.begin(), instances.end(), m_instances.begin() + index);
-    m_dirty = true;
+    mark_dirty(index, index + instances.size());
 }
 
-ref<Buffer> AccelerationStructureInstanceList::buffer() const
+void AccelerationStructureInstanceList::mark_dirty(size_t begin, size_t end)
+{
+    // Fall back to a single range if too many individual writes are tracked.
+    static constexpr size_t MAX_DIRTY_RANGES = 4096;
+    if (m_dirty_ranges.size() >= MAX_DIRTY_RANGES) {
+        for (const auto& range : m_dirty_ranges) {
+            begin = std::min(begin, range.first);
+            end = std::max(end, range.second);
+        }
+        m_dirty_ranges.clear();
+    }
+    m_dirty_ranges.emplace_back(begin, end);
+}
+
+void AccelerationStructureInstanceList::update(CommandEncoder* command_encoder) const
 {
-    if (m_dirty) {
-        size_t native_size = m_instances.size() * m_instance_stride;
+    SGL_CHECK_NOT_NULL(command_encoder);
+
+    // Grow the device buffer geometrically, all instances need to be uploaded to the new buffer.
+    if (!m_buffer || m_instances.size() > m_capacity) {
+        m_capacity = std::max({m_instances.size(), m_capacity + m_capacity / 2, size_t(1)});
+        m_buffer = create_device_buffer();
+        m_buffer_shared = false;
+        m_retired_buffers.clear();
+        m_dirty_ranges.clear();
+        m_dirty_ranges.emplace_back(0, m_instances.size());
+    }
 
-        std::unique_ptr<uint8_t[]> native_descs(new uint8_t[native_size]);
+    if (m_dirty_ranges.empty())
+        return;
+
+    // Merge overlapping and nearby ranges to reduce the number of uploads.
+    // Ranges past the end of the list are left over from shrinking the list and are dropped.
+    static constexpr size_t MERGE_GAP = 256;
+    std::sort(m_dirty_ranges.begin(), m_dirty_ranges.end());
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (auto [begin, end] : m_dirty_ranges) {
+        end = std::min(end, m_instances.size());
+        if (begin >= end)
+            continue;
+        if (!ranges.empty() && begin <= ranges.back().second + MERGE_GAP)
+            ranges.back().second = std::max(ranges.back().second, end);
+        else
+            ranges.emplace_back(begin, end);
+    }
+    m_dirty_ranges.clear();
 
+    std::vector<uint8_t> native_descs;
+    for (auto [begin, end] : ranges) {
+        size_t count = end - begin;
+        native_descs.resize(count * m_instance_stride);
         rhi::convertAccelerationStructureInstanceDescs(
-            m_instances.size(),
+            count,
             m_instance_type,
-            native_descs.get(),
+            native_descs.data(),
             m_instance_stride,
-            reinterpret_cast<const rhi::AccelerationStructureInstanceDescGeneric*>(m_instances.data()),
+            reinterpret_cast<const rhi::AccelerationStructureInstanceDescGeneric*>(m_instances.data() + begin),
             sizeof(rhi::AccelerationStructureInstanceDescGeneric)
         );
+        command_encoder->upload_buffer_data(
+            m_buffer,
+            begin * m_instance_stride,
+            native_descs.size(),
+            native_descs.data()
+        );
+    }
+}
 
-        m_buffer = m_device->create_buffer({
-            .usage = BufferUsage::acceleration_structure_build_input,
-            .data = native_descs.get(),
-            .data_size = native_size,
-        });
-
-        m_dirty = false;
+ref<Buffer> AccelerationStructureInstanceList::buffer() const
+{
+    if (!m_buffer || m_instances.size() > m_capacity || !m_dirty_ranges.empty()) {
+        // The upload is submitted right away. Command encoders that were recorded with the current buffer but are
+        // not submitted yet, and submitted work still running on the GPU, must not see the new instances. Unless
+        // there are none, upload the modified ranges to another buffer holding a copy of the instances.
+        bool in_use = m_device->_oldest_pending_command_encoder_id() != UINT64_MAX
+            || !m_device->is_submit_finished(m_device->last_submit_id());
+        bool replace = m_buffer && m_buffer_shared && in_use && m_instances.size() <= m_capacity;
+        ref<CommandEncoder> command_encoder = m_device->create_command_encoder();
+        if (replace)
+            replace_shared_buffer(command_encoder);
+        update(command_encoder);
+        m_device->submit_command_buffer(command_encoder->finish());
     }
 
+    m_buffer_shared = true;
     return m_buffer;
 }
 
+void AccelerationStructureInstanceList::replace_shared_buffer(CommandEncoder* command_encoder) const
+{
+    // Keep a few previously shared buffers, so alternating between them doesn't allocate new buffers.
+    static constexpr size_t MAX_RETIRED_BUFFERS = 2;
+
+    // Same as in BufferPool: once all command encoders that may have recorded a retired buffer are submitted,
+    // the last submit id covers all work using it. The encoder recording the copy below is still pending.
+    uint64_t oldest_pending = m_device->_oldest_pending_command_encoder_id();
+    uint64_t last_submit_id = m_device->last_submit_id();
+    for (RetiredBuffer& retired : m_retired_buffers)
+        if (retired.submit_id == UINT64_MAX && retired.command_encoder_id < oldest_pending)
+            retired.submit_id = last_submit_id;
+
+    ref<Buffer> buffer;
+    auto it = std::find_if(
+        m_retired_buffers.begin(),
+        m_retired_buffers.end(),
+        [&](const RetiredBuffer& retired)
+        {
+            return retired.submit_id != UINT64_MAX && m_device->is_submit_finished(retired.submit_id);
+        }
+    );
+    if (it != m_retired_buffers.end()) {
+        buffer = std::move(it->buffer);
+        m_retired_buffers.erase(it);
+    } else {
+        buffer = create_device_buffer();
+    }
+
+    if (!m_instances.empty())
+        command_encoder->copy_buffer(buffer, 0, m_buffer, 0, m_instances.size() * m_instance_stride);
+
+    // The command encoder recording the copy may have recorded the current buffer as well.
+    if (m_retired_buffers.size() >= MAX_RETIRED_BUFFERS)
+        m_retired_buffers.erase(m_retired_buffers.begin());
+    m_retired_buffers.push_back({
+        .buffer = std::move(m_buffer),
+        .command_encoder_id = m_device->_last_command_encoder_id(),
+        .submit_id = UINT64_MAX,
+    });
+    m_buffer = std::move(buffer);
+    m_buffer_shared = false;
+}
+
+ref<Buffer> AccelerationStructureInstanceList::create_device_buffer() const
+{
+    return m_device->create_buffer({
+        .size = m_capacity * m_instance_stride,
+        .usage = BufferUsage::acceleration_structure_build_input,
+    });
+}
+
 AccelerationStructureBuildInputInstances AccelerationStructureInstanceList::build_input_instances() const
 {
     return AccelerationStructureBuildInputInstances{
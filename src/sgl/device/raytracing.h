@@ -311,6 +311,21 @@ public:
     void write(size_t index, const AccelerationStructureInstanceDesc& instance);
     void write(size_t index, std::span<AccelerationStructureInstanceDesc> instances);
 
+    /// Upload modified instances to the device buffer.
+    /// Only instance ranges written since the last update are converted and uploaded.
+    /// The device buffer is reused and only reallocated when the list outgrows its capacity.
+    ///
+    /// Note: The upload overwrites the device buffer in place. Command encoders that were recorded with
+    /// the buffer but are submitted after \c command_encoder see the new instances. Record the update on
+    /// the same command encoder as the acceleration structure build that uses it.
+    /// \param command_encoder Command encoder to record the upload to.
+    void update(CommandEncoder* command_encoder) const;
+
+    /// Get the device buffer, uploading modified instances on a new command buffer if needed.
+    /// Once the buffer has been returned, modified instances are only uploaded to it in place if no command
+    /// encoder is pending and the GPU has finished all submitted work. Otherwise they are uploaded to another
+    /// buffer, so command encoders that were recorded with a previously returned buffer are not affected.
+    /// Previously returned buffers are reused once the work that may use them has finished.
     ref<Buffer> buffer() const;
 
     AccelerationStructureBuildInputInstances build_input_instances() const;
@@ -318,11 +333,31 @@ public:
     std::string to_string() const override;
 
 private:
+    struct RetiredBuffer {
+        ref<Buffer> buffer;
+        /// Last command encoder that may have recorded the buffer.
+        uint64_t command_encoder_id;
+        /// Submission that must be finished before the buffer can be reused (\c UINT64_MAX until known).
+        uint64_t submit_id;
+    };
+
+    void mark_dirty(size_t begin, size_t end);
+    ref<Buffer> create_device_buffer() const;
+    /// Replace the shared device buffer with a retired buffer that can be reused, or a new buffer.
+    void replace_shared_buffer(CommandEncoder* command_encoder) const;
+
     std::vector<AccelerationStructureInstanceDesc> m_instances;
     rhi::AccelerationStructureInstanceDescType m_instance_type;
     size_t m_instance_stride;
-    mutable bool m_dirty{true};
+    /// Instance ranges [begin, end) written since the last update.
+    mutable std::vector<std::pair<size_t, size_t>> m_dirty_ranges;
+    /// Number of instances the device buffer can hold.
+    mutable size_t m_capacity{0};
     mutable ref<Buffer> m_buffer;
+    /// True if \c m_buffer was returned by \c buffer() and may be referenced by unsubmitted command encoders.
+    mutable bool m_buffer_shared{false};
+    /// Previously shared buffers, oldest first.
+    mutable std::vector<RetiredBuffer> m_retired_buffers;
 };
 
 struct ShaderTableDesc {
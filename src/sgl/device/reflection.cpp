@@ -9,27 +9,155 @@
 
 #include "sgl/math/vector.h"
 
+#include <array>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <unordered_map>
 
 namespace sgl {
 
 namespace detail {
 
-    static std::map<void*, const BaseReflectionObject*> g_slang_reflection_to_sgl_reflection;
+    /// Cache mapping slang reflection pointers to their sgl wrappers.
+    /// Wrappers are not kept alive by the cache, they remove themselves when destroyed.
+    /// The map is split into shards with separate locks, so threads looking up different
+    /// reflection objects rarely contend.
+    ///
+    /// Wrappers owned by Python are deallocated while holding the GIL, and then take the shard lock
+    /// to remove themselves. Retaining them therefore needs the GIL, which is always acquired before
+    /// the shard lock and never while holding it.
+    class ReflectionCache {
+    public:
+        template<typename SGLType, typename SlangType>
+        ref<const SGLType> get_or_create(ref<const Object> owner, SlangType* slang_reflection)
+        {
+            Shard& shard = get_shard(slang_reflection);
+            const Object* owner_ptr = owner.get();
+            std::optional<PyGILGuard> gil;
+            ref<const SGLType> wrapper;
+
+            while (true) {
+                bool needs_gil = false;
+                const BaseReflectionObject* existing;
+                {
+                    std::lock_guard lock(shard.mutex);
+                    existing = shard.find(slang_reflection, gil.has_value(), needs_gil);
+                    // Another thread may have created a wrapper in the meantime, dead entries are replaced.
+                    if (!existing && wrapper && !needs_gil) {
+                        shard.entries[slang_reflection] = {wrapper.get(), owner_ptr};
+                        return wrapper;
+                    }
+                }
+                if (existing)
+                    return adopt<SGLType>(existing);
+
+                // Retry with the GIL if the wrapper is owned by Python. Otherwise create the wrapper
+                // outside of the lock, as constructors may query other wrappers.
+                if (needs_gil)
+                    gil.emplace();
+                else
+                    wrapper = make_ref<const SGLType>(std::move(owner), slang_reflection);
+            }
+        }
+
+        void remove(void* slang_reflection, const BaseReflectionObject* wrapper)
+        {
+            Shard& shard = get_shard(slang_reflection);
+            std::lock_guard lock(shard.mutex);
+            // The entry may already belong to a new wrapper if this one was destroyed concurrently.
+            auto it = shard.entries.find(slang_reflection);
+            if (it != shard.entries.end() && it->second.wrapper == wrapper)
+                shard.entries.erase(it);
+        }
+
+        /// Remove all wrappers whose owner matches the predicate and return them.
+        std::vector<ref<const BaseReflectionObject>>
+        remove_if(const std::function<bool(const Object* owner)>& predicate)
+        {
+            std::vector<ref<const BaseReflectionObject>> removed;
+            PyGILGuard gil;
+            for (Shard& shard : m_shards) {
+                std::lock_guard lock(shard.mutex);
+                for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                    if (predicate(it->second.owner)) {
+                        // Wrappers being destroyed concurrently are skipped, they are gone anyway.
+                        if (it->second.wrapper->try_inc_ref(true))
+                            removed.push_back(adopt<BaseReflectionObject>(it->second.wrapper));
+                        it = shard.entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            return removed;
+        }
+
+    private:
+        static constexpr size_t SHARD_COUNT = 32;
+
+        struct Entry {
+            const BaseReflectionObject* wrapper;
+            /// Owner of the wrapper, tracked separately so invalidation doesn't touch wrappers
+            /// that are being destroyed.
+            const Object* owner;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<void*, Entry> entries;
+
+            /// Find and retain a wrapper. Needs the shard lock.
+            /// Sets \c needs_gil if the wrapper is owned by Python and \c gil_held is not set.
+            /// The returned reference is released with \c adopt() after unlocking, as releasing
+            /// may need the GIL if the wrapper was handed over to Python in the meantime.
+            const BaseReflectionObject* find(void* slang_reflection, bool gil_held, bool& needs_gil)
+            {
+                auto it = entries.find(slang_reflection);
+                if (it == entries.end())
+                    return nullptr;
+                // Wrappers being destroyed only free their memory after removing their entry,
+                // so they can be safely accessed while holding the shard lock.
+                const BaseReflectionObject* wrapper = it->second.wrapper;
+                if (wrapper->try_inc_ref(gil_held))
+                    return wrapper;
+                needs_gil = !gil_held && wrapper->self_py() != nullptr;
+                return nullptr;
+            }
+        };
+
+        /// Move a reference retained by \c Shard::find() into a \c ref.
+        template<typename SGLType>
+        static ref<const SGLType> adopt(const BaseReflectionObject* wrapper)
+        {
+            ref<const SGLType> result(static_cast<const SGLType*>(wrapper));
+            wrapper->dec_ref();
+            return result;
+        }
+
+        Shard& get_shard(void* slang_reflection)
+        {
+            // Reflection objects are heap allocated, so the lowest bits carry little information.
+            uintptr_t hash = reinterpret_cast<uintptr_t>(slang_reflection) >> 4;
+            return m_shards[(hash ^ (hash >> 7)) % SHARD_COUNT];
+        }
+
+        std::array<Shard, SHARD_COUNT> m_shards;
+    };
+
+    static ReflectionCache& reflection_cache()
+    {
+        // Intentionally leaked, wrappers may be destroyed during static destruction.
+        static ReflectionCache* cache = new ReflectionCache();
+        return *cache;
+    }
 
     template<typename SGLType, typename SlangType>
     ref<const SGLType> create_reflection_type_from_slang_type(ref<const Object> owner, SlangType* slang_reflection)
     {
-        if (slang_reflection) {
-            auto it = g_slang_reflection_to_sgl_reflection.find(slang_reflection);
-            if (it != g_slang_reflection_to_sgl_reflection.end()) {
-                return ref((const SGLType*)it->second);
-            } else {
-                auto res = make_ref<const SGLType>(std::move(owner), slang_reflection);
-                g_slang_reflection_to_sgl_reflection[slang_reflection] = res.get();
-                return res;
-            }
-        } else
+        if (slang_reflection)
+            return reflection_cache().get_or_create<SGLType>(std::move(owner), slang_reflection);
+        else
             return nullptr;
     }
 
@@ -51,17 +179,23 @@ namespace detail {
 
 #undef SGL_FROM_SLANG
 
-    void on_slang_wrapper_destroyed(void* slang_reflection)
+    void on_slang_wrapper_destroyed(void* slang_reflection, const BaseReflectionObject* wrapper)
     {
-        g_slang_reflection_to_sgl_reflection.erase(slang_reflection);
+        if (slang_reflection)
+            reflection_cache().remove(slang_reflection, wrapper);
     }
 
     void invalidate_all_reflection_data()
     {
-        for (auto& [_, reflection] : g_slang_reflection_to_sgl_reflection) {
-            const_cast<BaseReflectionObject*>(reflection)->_hot_reload_invalidate();
-        }
-        g_slang_reflection_to_sgl_reflection.clear();
+        invalidate_reflection_data([](const Object*) { return true; });
+    }
+
+    void invalidate_reflection_data(const std::function<bool(const Object* owner)>& predicate)
+    {
+        // Remove entries before invalidating, as releasing owners can destroy other wrappers.
+        std::vector<ref<const BaseReflectionObject>> invalidated = reflection_cache().remove_if(predicate);
+        for (const auto& reflection : invalidated)
+            const_cast<BaseReflectionObject*>(reflection.get())->_hot_reload_invalidate();
     }
 } // namespace detail
 
@@ -14,12 +14,15 @@
 
 #include <slang.h>
 
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
 
 namespace sgl {
 
+class BaseReflectionObject;
+
 namespace detail {
 
     SGL_API ref<const DeclReflection> from_slang(ref<const Object> owner, slang::DeclReflection* decl_reflection);
@@ -37,9 +40,12 @@ namespace detail {
     SGL_API ref<const ProgramLayout> from_slang(ref<const Object> owner, slang::ProgramLayout* program_layout);
     SGL_API ref<const Attribute> from_slang(ref<const Object> owner, slang::Attribute* attribute);
 
-    SGL_API void on_slang_wrapper_destroyed(void* slang_reflection);
+    SGL_API void on_slang_wrapper_destroyed(void* slang_reflection, const BaseReflectionObject* wrapper);
 
     SGL_API void invalidate_all_reflection_data();
+
+    /// Invalidate reflection data of all reflection objects whose owner matches the predicate.
+    SGL_API void invalidate_reflection_data(const std::function<bool(const Object* owner)>& predicate);
 } // namespace detail
 
 
@@ -199,6 +205,9 @@ public:
 
     bool is_valid() const { return m_owner != nullptr; }
 
+    /// Object owning the underlying slang reflection data (module, program or shader object).
+    const Object* _owner() const { return m_owner.get(); }
+
 protected:
     ref<const Object> m_owner;
 };
@@ -211,7 +220,7 @@ public:
         , m_target(target)
     {
     }
-    ~BaseReflectionObjectImpl() { detail::on_slang_wrapper_destroyed(m_target); }
+    ~BaseReflectionObjectImpl() { detail::on_slang_wrapper_destroyed(m_target, this); }
 
     SlangType* slang_target() const
     {
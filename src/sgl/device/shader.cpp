@@ -219,10 +219,23 @@ SlangSession::~SlangSession()
         m_device->_hot_reload()->_unregister_slang_session(this);
 }
 
+std::unique_lock<std::recursive_mutex> SlangSession::_lock()
+{
+    std::unique_lock lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        // The holder may be waiting for the GIL (e.g. to retain a module owned by Python).
+        PyGILRelease gil;
+        lock.lock();
+    }
+    return lock;
+}
+
 void SlangSession::recreate_session()
 {
     SGL_CHECK_NOT_NULL(m_device);
 
+    auto lock = _lock();
+
     SlangSessionBuild build;
 
     // Build everything first.
@@ -487,6 +500,8 @@ void SlangSession::create_session(SlangSessionBuild& build)
 
 ref<SlangModule> SlangSession::load_module(std::string_view module_name)
 {
+    auto lock = _lock();
+
     SlangModuleDesc desc;
     desc.module_name = module_name;
 
@@ -510,6 +525,8 @@ ref<SlangModule> SlangSession::load_module_from_source(
     std::optional<std::filesystem::path> path
 )
 {
+    auto lock = _lock();
+
     SlangModuleDesc desc;
     desc.module_name = module_name;
     desc.source = source;
@@ -529,34 +546,87 @@ ref<SlangModule> SlangSession::load_module_from_source(
     return module;
 }
 
+ref<SlangModule> SlangSession::load_module_from_serialized(
+    std::string_view module_name,
+    std::span<const uint8_t> serialized,
+    std::string_view source
+)
+{
+    auto lock = _lock();
+
+    SlangModuleDesc desc;
+    desc.module_name = module_name;
+    desc.source = source;
+    desc.serialized = std::vector<uint8_t>(serialized.begin(), serialized.end());
+
+    ref<SlangModule> module = make_ref<SlangModule>(ref(this), desc);
+
+    // Setup build info with just this session in and load/store the module.
+    SlangSessionBuild build;
+    build.session = m_data;
+    module->load(build);
+    module->store_built_data(build);
+
+    // Update cache of loaded modules.
+    update_module_cache_and_dependencies();
+
+    return module;
+}
+
 ref<ShaderProgram> SlangSession::link_program(
     std::vector<ref<SlangModule>> modules,
     std::vector<ref<SlangEntryPoint>> entry_points,
     std::optional<SlangLinkOptions> link_options
 )
 {
-    for (const auto& module : modules)
+    auto lock = _lock();
+
+    ref<ShaderProgram> program = create_program({
+        .modules = std::move(modules),
+        .entry_points = std::move(entry_points),
+        .link_options = std::move(link_options),
+    });
+
+    // Update cache of loaded modules, as it may have changed after program link.
+    update_module_cache_and_dependencies();
+
+    return program;
+}
+
+std::vector<ref<ShaderProgram>> SlangSession::link_programs(std::vector<ShaderProgramDesc> descs)
+{
+    auto lock = _lock();
+
+    std::vector<ref<ShaderProgram>> programs;
+    programs.reserve(descs.size());
+    for (ShaderProgramDesc& desc : descs)
+        programs.push_back(create_program(std::move(desc)));
+
+    // Update cache of loaded modules, as it may have changed after program link.
+    update_module_cache_and_dependencies();
+
+    return programs;
+}
+
+ref<ShaderProgram> SlangSession::create_program(ShaderProgramDesc desc)
+{
+    for (const auto& module : desc.modules)
         SGL_CHECK(module->session() == this, "All modules must belong to this session.");
-    for (const auto& entry_point : entry_points)
+    for (const auto& entry_point : desc.entry_points)
         SGL_CHECK(entry_point->module()->session() == this, "All entry points must belong to this session.");
 
     // Link NVAPI module if available.
     if (SGL_HAS_NVAPI && m_device->type() == DeviceType::d3d12)
-        modules.push_back(m_nvapi_module);
+        desc.modules.push_back(m_nvapi_module);
 
     // Generate label
-    std::string label;
-    for (const auto& entry_point : entry_points) {
-        label += (label.empty() ? "" : ", ") + entry_point->module()->name() + ":" + entry_point->name();
+    if (desc.label.empty()) {
+        std::string& label = desc.label;
+        for (const auto& entry_point : desc.entry_points) {
+            label += (label.empty() ? "" : ", ") + entry_point->module()->name() + ":" + entry_point->name();
+        }
     }
 
-    ShaderProgramDesc desc{
-        .modules = modules,
-        .entry_points = entry_points,
-        .link_options = link_options,
-        .label = label,
-    };
-
     auto program = make_ref<ShaderProgram>(ref(device()), ref(this), desc);
 
     // Setup build with this session and populate with all relevant
@@ -570,9 +640,6 @@ ref<ShaderProgram> SlangSession::link_program(
     program->link(build);
     program->store_built_data(build);
 
-    // Update cache of loaded modules, as it may have changed after program link.
-    update_module_cache_and_dependencies();
-
     return program;
 }
 
@@ -801,24 +868,45 @@ void SlangModule::load(SlangSessionBuild& build_data) const
             throw SlangCompileError(msg);
         }
     } else {
-        // TODO workaround: slang doesn't like loading the same source twice
-        static uint32_t id = 0;
-        std::string source_str = fmt::format("// {}\n{}", id++, desc.source);
+        slang_module = nullptr;
+
+        // Try to load the serialized module first. Hot reload always recompiles the source.
+        if (desc.serialized && !m_data) {
+            UnownedSlangBlob blob(desc.serialized->data(), desc.serialized->size());
+            SGL_CATCH_INTERNAL_SLANG_ERROR(
+                slang_module = session_data->slang_session->loadModuleFromIRBlob(
+                    desc.module_name.c_str(),
+                    desc.path ? desc.path->string().c_str() : nullptr,
+                    &blob,
+                    diagnostics.writeRef()
+                )
+            );
+            if (!slang_module) {
+                log_debug("Failed to load serialized slang module \"{}\", compiling source", desc.module_name);
+                diagnostics = nullptr;
+            }
+        }
 
-        SGL_CATCH_INTERNAL_SLANG_ERROR(
-            slang_module = session_data->slang_session->loadModuleFromSourceString(
-                std::string{desc.module_name}.c_str(),
-                desc.path ? desc.path->string().c_str() : nullptr,
-                source_str.c_str(),
-                diagnostics.writeRef()
-            )
-        );
         if (!slang_module) {
-            std::string msg = append_diagnostics(
-                fmt::format("Failed to load slang module \"{}\" from source", desc.module_name),
-                diagnostics
+            // TODO workaround: slang doesn't like loading the same source twice
+            static uint32_t id = 0;
+            std::string source_str = fmt::format("// {}\n{}", id++, desc.source);
+
+            SGL_CATCH_INTERNAL_SLANG_ERROR(
+                slang_module = session_data->slang_session->loadModuleFromSourceString(
+                    std::string{desc.module_name}.c_str(),
+                    desc.path ? desc.path->string().c_str() : nullptr,
+                    source_str.c_str(),
+                    diagnostics.writeRef()
+                )
             );
-            throw SlangCompileError(msg);
+            if (!slang_module) {
+                std::string msg = append_diagnostics(
+                    fmt::format("Failed to load slang module \"{}\" from source", desc.module_name),
+                    diagnostics
+                );
+                throw SlangCompileError(msg);
+            }
         }
     }
 
@@ -871,8 +959,23 @@ std::vector<ref<SlangEntryPoint>> SlangModule::entry_points() const
     return entry_points;
 }
 
+std::vector<std::filesystem::path> SlangModule::dependencies() const
+{
+    return detail::get_module_dependencies(m_data->slang_module);
+}
+
+std::vector<uint8_t> SlangModule::serialize() const
+{
+    Slang::ComPtr<ISlangBlob> blob;
+    SLANG_CALL(m_data->slang_module->serialize(blob.writeRef()));
+    const uint8_t* data = static_cast<const uint8_t*>(blob->getBufferPointer());
+    return std::vector<uint8_t>(data, data + blob->getBufferSize());
+}
+
 ref<SlangEntryPoint> SlangModule::entry_point(std::string_view name, std::span<TypeConformance> type_conformances) const
 {
+    auto lock = session()->_lock();
+
     SlangEntryPointDesc desc;
     desc.name = name;
     desc.type_conformances.assign(type_conformances.begin(), type_conformances.end());
@@ -891,6 +994,7 @@ ref<SlangEntryPoint> SlangModule::entry_point(std::string_view name, std::span<T
 
 bool SlangModule::has_entry_point(std::string_view name) const
 {
+    auto lock = session()->_lock();
     Slang::ComPtr<slang::IEntryPoint> slang_entry_point;
     m_data->slang_module->findEntryPointByName(std::string{name}.c_str(), slang_entry_point.writeRef());
     return slang_entry_point != nullptr;
@@ -1248,6 +1352,35 @@ void ShaderProgram::store_built_data(SlangSessionBuild& build_data)
     }
 }
 
+void ShaderProgram::generate_target_code() const
+{
+    auto lock = m_session->_lock();
+
+    Timer timer;
+
+    slang::IComponentType* linked_program = m_data->linked_program;
+    SlangUInt entry_point_count = linked_program->getLayout()->getEntryPointCount();
+    for (SlangUInt i = 0; i < entry_point_count; ++i) {
+        // Sessions are created with a single target.
+        Slang::ComPtr<ISlangBlob> code;
+        Slang::ComPtr<ISlangBlob> diagnostics;
+        if (SLANG_FAILED(linked_program->getEntryPointCode(SlangInt(i), 0, code.writeRef(), diagnostics.writeRef()))) {
+            std::string msg = append_diagnostics(
+                fmt::format("Failed to generate target code for program \"{}\"", m_desc.label),
+                diagnostics
+            );
+            throw SlangCompileError(msg);
+        }
+        report_diagnostics(diagnostics);
+    }
+
+    log_debug(
+        "Generating target code for program \"{}\" took {}",
+        m_desc.label,
+        string::format_duration(timer.elapsed_s())
+    );
+}
+
 void ShaderProgram::_register_pipeline(Pipeline* pipeline)
 {
     m_registered_pipelines.insert(pipeline);
@@ -12,6 +12,7 @@
 
 #include <exception>
 #include <map>
+#include <mutex>
 #include <set>
 #include <span>
 #include <string>
@@ -276,6 +277,9 @@ public:
     Device* device() const { return m_device; }
     const SlangSessionDesc& desc() const { return m_desc; }
 
+    /// Unique hash of the session options.
+    const std::string& uid() const { return m_data->uid; }
+
     /// Load a module by name.
     ref<SlangModule> load_module(std::string_view module_name);
 
@@ -286,6 +290,15 @@ public:
         std::optional<std::filesystem::path> path = {}
     );
 
+    /// Load a module from a serialized module (see \c SlangModule::serialize()).
+    /// This skips parsing and checking the source code. The source code is compiled instead
+    /// if the serialized module cannot be loaded (e.g. if it was created by a different Slang version).
+    ref<SlangModule> load_module_from_serialized(
+        std::string_view module_name,
+        std::span<const uint8_t> serialized,
+        std::string_view source
+    );
+
     /// Link a program with a set of modules and entry points.
     ref<ShaderProgram> link_program(
         std::vector<ref<SlangModule>> modules,
@@ -293,6 +306,11 @@ public:
         std::optional<SlangLinkOptions> link_options = {}
     );
 
+    /// Link a batch of programs. This is faster than calling \c link_program for each program,
+    /// as the session is locked and the module cache updated only once for the whole batch.
+    /// Programs without a label are labeled the same way as by \c link_program.
+    std::vector<ref<ShaderProgram>> link_programs(std::vector<ShaderProgramDesc> descs);
+
     /// Load a program from a given module with a set of entry
     /// points. Internally this simply wraps link_program without
     /// requiring the user to explicitly load modules.
@@ -319,6 +337,11 @@ public:
     // Internal access to the built session data.
     ref<SlangSessionData> _data() { return m_data; }
 
+    /// Lock serializing access to the Slang session, which is not thread safe.
+    /// Threads holding the lock may acquire the GIL (e.g. to retain objects owned by Python), so the GIL
+    /// is always acquired after the lock: if the lock is held by another thread, the GIL is released while waiting.
+    std::unique_lock<std::recursive_mutex> _lock();
+
 private:
     ref<Device> m_device;
 
@@ -338,6 +361,9 @@ private:
     /// All created sgl programs (via link_program)
     std::set<ShaderProgram*> m_registered_programs;
 
+    std::recursive_mutex m_mutex;
+
+    ref<ShaderProgram> create_program(ShaderProgramDesc desc);
     void update_module_cache_and_dependencies();
     bool write_module_to_cache(slang::IModule* module);
     void create_session(SlangSessionBuild& build);
@@ -352,6 +378,11 @@ struct SlangModuleDesc {
 
     /// If source specified, additional path for compilation.
     std::optional<std::filesystem::path> path;
+
+    /// Optional serialized module (see \c SlangModule::serialize()) to load instead of compiling \c source.
+    /// Falls back to compiling \c source if the serialized module cannot be loaded.
+    /// Only used for the initial load, hot reload always recompiles \c source.
+    std::optional<std::vector<uint8_t>> serialized;
 };
 
 struct SlangModuleData : Object {
@@ -399,6 +430,12 @@ public:
     /// Build and return vector of all current entry points in the module.
     std::vector<ref<SlangEntryPoint>> entry_points() const;
 
+    /// Absolute paths of all files this module depends on (including the module source itself).
+    std::vector<std::filesystem::path> dependencies() const;
+
+    /// Serialize the module (Slang IR), so it can be loaded with \c SlangSession::load_module_from_serialized().
+    std::vector<uint8_t> serialize() const;
+
     /// Get an entry point, optionally applying type conformances to it.
     ref<SlangEntryPoint> entry_point(
         std::string_view name,
@@ -513,6 +550,8 @@ public:
 
     const ShaderProgramDesc& desc() const { return m_desc; }
 
+    SlangSession* session() const { return m_session; }
+
     ref<const ProgramLayout> layout() const
     {
         return ProgramLayout::from_slang(ref(this), m_data->linked_program->getLayout());
@@ -522,6 +561,14 @@ public:
 
     rhi::IShaderProgram* rhi_shader_program() const { return m_data->rhi_shader_program; }
 
+    /// True if the program has specialization parameters, in which case slang-rhi compiles
+    /// target code for each specialization it is bound with.
+    bool _is_specializable() const { return m_data->linked_program->getSpecializationParamCount() > 0; }
+
+    /// Generate target code for all entry points. Slang keeps the generated code with the
+    /// linked program, so creating pipelines afterwards does not run the Slang compiler again.
+    void generate_target_code() const;
+
     virtual std::string to_string() const override;
 
     void _register_pipeline(Pipeline* pipeline);
@@ -28,8 +28,19 @@ public:
     ShaderCursor(ShaderObject* shader_object);
     ShaderCursor(ShaderObject* shader_object, bool need_dereference, slang::TypeLayoutReflection* parent_type_layout);
 
+    /// Create a cursor pointing at an already resolved location within a shader object.
+    /// Used to replay offsets recorded from an earlier lookup without going through reflection.
+    ShaderCursor(ShaderObject* shader_object, slang::TypeLayoutReflection* type_layout, ShaderOffset offset)
+        : m_type_layout(type_layout)
+        , m_shader_object(shader_object)
+        , m_offset(offset)
+    {
+    }
+
     ShaderOffset offset() const { return m_offset; }
 
+    ShaderObject* shader_object() const { return m_shader_object; }
+
     bool is_valid() const { return m_offset.is_valid(); }
 
     std::string to_string() const;
@@ -14,7 +14,11 @@
 #include "sgl/core/timer.h"
 #include "sgl/core/thread.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <thread>
 
 namespace sgl {
 
@@ -26,6 +30,100 @@ struct SourceImage {
     ref<Bitmap> bitmap;
     ref<DDSFile> dds_file;
     Format format{Format::undefined};
+
+    /// Size of the image data held in memory.
+    size_t size() const
+    {
+        if (bitmap)
+            return bitmap->buffer_size();
+        if (dds_file)
+            return dds_file->size();
+        return 0;
+    }
+};
+
+/**
+ * \brief Streams source images from asynchronous load tasks to the consumer.
+ *
+ * Source images are loaded (and converted) in parallel, ahead of the consumer, as long as
+ * the loaded image data held in memory stays below \c max_in_flight_bytes. Images are consumed
+ * in order and released as soon as the consumer is done with them, which in turn allows
+ * more images to be loaded. The number of concurrently running load tasks is bounded as well,
+ * so the memory limit is exceeded by at most a few images.
+ */
+class SourceImageStream {
+public:
+    using LoadFunc = std::function<SourceImage(size_t index)>;
+
+    SourceImageStream(size_t count, size_t max_in_flight_bytes, LoadFunc load_func)
+        : m_images(count)
+        , m_tasks(count, nullptr)
+        , m_load_func(std::move(load_func))
+        , m_max_in_flight_bytes(max_in_flight_bytes)
+        , m_max_tasks(std::max(2u, std::thread::hardware_concurrency()))
+    {
+        launch();
+    }
+
+    ~SourceImageStream()
+    {
+        for (thread::TaskHandle task : m_tasks)
+            if (task)
+                thread::task_wait_and_release(task);
+    }
+
+    /// Wait for the source image at \c index to be loaded.
+    /// Images need to be consumed in order.
+    SourceImage& wait(size_t index)
+    {
+        SGL_ASSERT(index == m_released);
+        // Always make progress, even if the memory limit is exceeded.
+        if (m_launched == index)
+            launch_one();
+        thread::TaskHandle task = m_tasks[index];
+        m_tasks[index] = nullptr;
+        thread::task_wait_and_release(task);
+        return m_images[index];
+    }
+
+    /// Release the source image at \c index and load more images.
+    void release(size_t index)
+    {
+        SGL_ASSERT(index == m_released);
+        m_in_flight_bytes.fetch_sub(m_images[index].size());
+        m_images[index] = {};
+        m_released++;
+        launch();
+    }
+
+private:
+    void launch()
+    {
+        while (m_launched < m_images.size() && m_launched - m_released < m_max_tasks
+               && m_in_flight_bytes.load() < m_max_in_flight_bytes)
+            launch_one();
+    }
+
+    void launch_one()
+    {
+        size_t index = m_launched++;
+        m_tasks[index] = thread::do_async(
+            [this, index]()
+            {
+                m_images[index] = m_load_func(index);
+                m_in_flight_bytes.fetch_add(m_images[index].size());
+            }
+        );
+    }
+
+    std::vector<SourceImage> m_images;
+    std::vector<thread::TaskHandle> m_tasks;
+    LoadFunc m_load_func;
+    size_t m_max_in_flight_bytes;
+    size_t m_max_tasks;
+    size_t m_launched{0};
+    size_t m_released{0};
+    std::atomic<size_t> m_in_flight_bytes{0};
 };
 
 /**
@@ -186,9 +284,10 @@ inline std::pair<TextureType, uint32_t> get_texture_type_and_layer_count(DDSFile
 inline SourceImage convert_bitmap(Device* device, ref<Bitmap> bitmap, const TextureLoader::Options& options)
 {
     auto [format, convert_to_rgba] = determine_texture_format(device, bitmap, options);
+    // Bitmaps are already loaded and converted in parallel, one task per bitmap.
     return SourceImage{
         .bitmap = convert_to_rgba
-            ? bitmap->convert(Bitmap::PixelFormat::rgba, bitmap->component_type(), bitmap->srgb_gamma())
+            ? bitmap->convert(Bitmap::PixelFormat::rgba, bitmap->component_type(), bitmap->srgb_gamma(), false)
             : bitmap,
         .format = format,
     };
@@ -199,7 +298,9 @@ inline SourceImage load_source_image(const std::filesystem::path& path)
     SourceImage source_image;
     FileStream stream(path, FileStream::Mode::read);
     if (DDSFile::detect_dds_file(&stream)) {
-        source_image.dds_file = ref(new DDSFile(&stream));
+        // Memory map DDS files, subresources are uploaded directly from the mapping.
+        stream.close();
+        source_image.dds_file = ref(new DDSFile(path));
         source_image.format = get_format(DXGI_FORMAT(source_image.dds_file->dxgi_format()));
     } else if (Bitmap::detect_file_format(&stream) != Bitmap::FileFormat::unknown) {
         source_image.bitmap = ref(new Bitmap(&stream));
@@ -294,17 +395,17 @@ inline ref<Texture> create_texture(
 inline std::vector<ref<Texture>> create_textures(
     Device* device,
     Blitter* blitter,
-    std::span<SourceImage> source_images,
-    std::span<thread::TaskHandle> source_image_tasks,
+    size_t count,
+    SourceImageStream& source_images,
     const TextureLoader::Options& options
 )
 {
-    SGL_ASSERT(source_images.size() == source_image_tasks.size());
-    std::vector<ref<Texture>> textures(source_images.size());
+    std::vector<ref<Texture>> textures(count);
     ref<CommandEncoder> command_encoder = device->create_command_encoder();
-    for (size_t i = 0; i < source_images.size(); ++i) {
-        thread::task_wait_and_release(source_image_tasks[i]);
-        textures[i] = create_texture(device, blitter, command_encoder, source_images[i], options);
+    for (size_t i = 0; i < count; ++i) {
+        textures[i] = create_texture(device, blitter, command_encoder, source_images.wait(i), options);
+        // Image data is copied to staging memory when recording the upload, release it right away.
+        source_images.release(i);
         if (i && (i % BATCH_SIZE == 0)) {
             device->submit_command_buffer(command_encoder->finish());
             command_encoder = device->create_command_encoder();
@@ -318,13 +419,12 @@ inline std::vector<ref<Texture>> create_textures(
 inline ref<Texture> create_texture_array(
     Device* device,
     Blitter* blitter,
-    std::span<SourceImage> source_images,
-    std::span<thread::TaskHandle> source_image_tasks,
+    size_t count,
+    SourceImageStream& source_images,
     const TextureLoader::Options& options
 )
 {
-    SGL_ASSERT(source_images.size() == source_image_tasks.size());
-    SGL_ASSERT(source_images.size() > 0);
+    SGL_ASSERT(count > 0);
 
     bool allocate_mips = options.allocate_mips || options.generate_mips;
 
@@ -339,9 +439,8 @@ inline ref<Texture> create_texture_array(
 
     ref<CommandEncoder> command_encoder = device->create_command_encoder();
 
-    for (size_t i = 0; i < source_images.size(); ++i) {
-        thread::task_wait_and_release(source_image_tasks[i]);
-        SourceImage source_image = source_images[i];
+    for (size_t i = 0; i < count; ++i) {
+        const SourceImage& source_image = source_images.wait(i);
         const Bitmap* bitmap = source_image.bitmap;
         if (!bitmap)
             SGL_THROW("Texture array requires all source images to be bitmaps");
@@ -352,7 +451,7 @@ inline ref<Texture> create_texture_array(
                 .format = source_image.format,
                 .width = bitmap->width(),
                 .height = bitmap->height(),
-                .array_length = narrow_cast<uint32_t>(source_images.size()),
+                .array_length = narrow_cast<uint32_t>(count),
                 .mip_count = allocate_mips ? ALL_MIPS : 1u,
                 .usage = usage,
             });
@@ -379,6 +478,9 @@ inline ref<Texture> create_texture_array(
 
         if (options.generate_mips)
             blitter->generate_mips(command_encoder, texture, narrow_cast<uint32_t>(i));
+
+        // Image data is copied to staging memory when recording the upload, release it right away.
+        source_images.release(i);
     }
     device->submit_command_buffer(command_encoder->finish());
 
@@ -419,18 +521,16 @@ TextureLoader::load_textures(std::span<const Bitmap*> bitmaps, std::optional<Opt
     Options options = options_.value_or(Options{});
 
     // Convert bitmaps in parallel.
-    std::vector<SourceImage> source_images(bitmaps.size());
-    std::vector<thread::TaskHandle> source_image_tasks(bitmaps.size());
-    for (size_t i = 0; i < bitmaps.size(); ++i) {
-        source_image_tasks[i] = thread::do_async(
-            [&, i]()
-            {
-                source_images[i] = convert_bitmap(m_device, ref(const_cast<Bitmap*>(bitmaps[i])), options);
-            }
-        );
-    }
+    SourceImageStream source_images(
+        bitmaps.size(),
+        options.max_in_flight_bytes,
+        [&](size_t i)
+        {
+            return convert_bitmap(m_device, ref(const_cast<Bitmap*>(bitmaps[i])), options);
+        }
+    );
     // Wait for conversions and create textures.
-    return create_textures(m_device, m_blitter, source_images, source_image_tasks, options);
+    return create_textures(m_device, m_blitter, bitmaps.size(), source_images, options);
 }
 
 std::vector<ref<Texture>>
@@ -439,18 +539,16 @@ TextureLoader::load_textures(std::span<std::filesystem::path> paths, std::option
     Options options = options_.value_or(Options{});
 
     // Load & convert source images in parallel.
-    std::vector<SourceImage> source_images(paths.size());
-    std::vector<thread::TaskHandle> source_image_tasks(paths.size());
-    for (size_t i = 0; i < paths.size(); ++i) {
-        source_image_tasks[i] = thread::do_async(
-            [&, i]()
-            {
-                source_images[i] = load_and_convert_source_image(m_device, paths[i], options);
-            }
-        );
-    }
+    SourceImageStream source_images(
+        paths.size(),
+        options.max_in_flight_bytes,
+        [&](size_t i)
+        {
+            return load_and_convert_source_image(m_device, paths[i], options);
+        }
+    );
     // Wait for conversions and create textures.
-    return create_textures(m_device, m_blitter, source_images, source_image_tasks, options);
+    return create_textures(m_device, m_blitter, paths.size(), source_images, options);
 }
 
 ref<Texture> TextureLoader::load_texture_array(std::span<const Bitmap*> bitmaps, std::optional<Options> options_)
@@ -461,18 +559,16 @@ ref<Texture> TextureLoader::load_texture_array(std::span<const Bitmap*> bitmaps,
     Options options = options_.value_or(Options{});
 
     // Convert bitmaps in parallel.
-    std::vector<SourceImage> source_images(bitmaps.size());
-    std::vector<thread::TaskHandle> source_image_tasks(bitmaps.size());
-    for (size_t i = 0; i < bitmaps.size(); ++i) {
-        source_image_tasks[i] = thread::do_async(
-            [&, i]()
-            {
-                source_images[i] = convert_bitmap(m_device, ref(const_cast<Bitmap*>(bitmaps[i])), options);
-            }
-        );
-    }
+    SourceImageStream source_images(
+        bitmaps.size(),
+        options.max_in_flight_bytes,
+        [&](size_t i)
+        {
+            return convert_bitmap(m_device, ref(const_cast<Bitmap*>(bitmaps[i])), options);
+        }
+    );
     // Wait for conversions and create texture array.
-    return create_texture_array(m_device, m_blitter, source_images, source_image_tasks, options);
+    return create_texture_array(m_device, m_blitter, bitmaps.size(), source_images, options);
 }
 
 ref<Texture> TextureLoader::load_texture_array(std::span<std::filesystem::path> paths, std::optional<Options> options_)
@@ -483,18 +579,16 @@ ref<Texture> TextureLoader::load_texture_array(std::span<std::filesystem::path>
     Options options = options_.value_or(Options{});
 
     // Load & convert source images in parallel.
-    std::vector<SourceImage> source_images(paths.size());
-    std::vector<thread::TaskHandle> source_image_tasks(paths.size());
-    for (size_t i = 0; i < paths.size(); ++i) {
-        source_image_tasks[i] = thread::do_async(
-            [&, i]()
-            {
-                source_images[i] = load_and_convert_source_image(m_device, paths[i], options);
-            }
-        );
-    }
+    SourceImageStream source_images(
+        paths.size(),
+        options.max_in_flight_bytes,
+        [&](size_t i)
+        {
+            return load_and_convert_source_image(m_device, paths[i], options);
+        }
+    );
     // Wait for conversions and create texture array.
-    return create_texture_array(m_device, m_blitter, source_images, source_image_tasks, options);
+    return create_texture_array(m_device, m_blitter, paths.size(), source_images, options);
 }
 
 } // namespace sgl
@@ -35,6 +35,9 @@ public:
         /// Resource usage flags for the texture.
         /// \c TextureUsage::render_target will be added automatically if \c generate_mips is true.
         TextureUsage usage{TextureUsage::shader_resource};
+        /// Maximum size of loaded image data held in memory when loading multiple textures.
+        /// Images are loaded ahead of the upload until this limit is reached and released once uploaded.
+        size_t max_in_flight_bytes{1024ull * 1024 * 1024};
     };
 
     /**
@@ -3,11 +3,20 @@
 #include "nanobind.h"
 
 #include "sgl/core/bitmap.h"
+#include "sgl/core/bitmap_writer.h"
 #include "sgl/core/memory_stream.h"
 #include "sgl/core/string.h"
 
 #include "sgl/stl/bit.h" // Replace with <bit> when available on all platforms.
 
+namespace sgl {
+using BitmapWriterOptions = BitmapWriter::Options;
+SGL_DICT_TO_DESC_BEGIN(BitmapWriterOptions)
+SGL_DICT_TO_DESC_FIELD(max_pending_bytes, size_t)
+SGL_DICT_TO_DESC_FIELD(overflow_policy, BitmapWriter::OverflowPolicy)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
 SGL_PY_EXPORT(core_bitmap)
 {
     using namespace sgl;
@@ -200,8 +209,8 @@ SGL_PY_EXPORT(core_bitmap)
         .def_prop_ro("buffer_size", &Bitmap::buffer_size, D(Bitmap, buffer_size))
         .def("empty", &Bitmap::empty, D(Bitmap, empty))
         .def("clear", &Bitmap::clear, D(Bitmap, clear))
-        .def("vflip", &Bitmap::vflip, D(Bitmap, vflip))
-        .def("split", &Bitmap::split, D(Bitmap, split))
+        .def("vflip", &Bitmap::vflip, "parallel"_a = true, D(Bitmap, vflip))
+        .def("split", &Bitmap::split, "parallel"_a = true, D(Bitmap, split))
         .def(
             "convert",
             [](Bitmap& self,
@@ -231,6 +240,7 @@ SGL_PY_EXPORT(core_bitmap)
         .def(
             "write_async",
             &Bitmap::write_async,
+            nb::call_guard<nb::gil_scoped_release>(),
             "path"_a,
             "format"_a = Bitmap::FileFormat::auto_,
             "quality"_a = -1,
@@ -243,6 +253,13 @@ SGL_PY_EXPORT(core_bitmap)
             "format"_a = Bitmap::FileFormat::auto_,
             D(Bitmap, read_multiple)
         )
+        .def_static(
+            "set_exr_thread_count",
+            &Bitmap::set_exr_thread_count,
+            "count"_a,
+            D_NA(Bitmap, set_exr_thread_count)
+        )
+        .def_static("exr_thread_count", &Bitmap::exr_thread_count, D_NA(Bitmap, exr_thread_count))
         .def(nb::self == nb::self)
         .def(nb::self != nb::self)
         .def_prop_ro(
@@ -308,4 +325,59 @@ SGL_PY_EXPORT(core_bitmap)
                 return nb::str(html.c_str());
             }
         );
+
+    nb::class_<BitmapWriter, Object> bitmap_writer(m, "BitmapWriter", D_NA(BitmapWriter));
+
+    nb::sgl_enum<BitmapWriter::OverflowPolicy>(bitmap_writer, "OverflowPolicy", D_NA(BitmapWriter, OverflowPolicy));
+
+    nb::class_<BitmapWriter::Options>(bitmap_writer, "Options", D_NA(BitmapWriter, Options))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](BitmapWriter::Options* self, nb::dict dict)
+            {
+                new (self) BitmapWriter::Options(dict_to_BitmapWriterOptions(dict));
+            }
+        )
+        .def_rw(
+            "max_pending_bytes",
+            &BitmapWriter::Options::max_pending_bytes,
+            D_NA(BitmapWriter, Options, max_pending_bytes)
+        )
+        .def_rw(
+            "overflow_policy",
+            &BitmapWriter::Options::overflow_policy,
+            D_NA(BitmapWriter, Options, overflow_policy)
+        );
+
+    nb::implicitly_convertible<nb::dict, BitmapWriter::Options>();
+
+    nb::class_<BitmapWriter::WriteResult>(bitmap_writer, "WriteResult", D_NA(BitmapWriter, WriteResult))
+        .def_ro("path", &BitmapWriter::WriteResult::path, D_NA(BitmapWriter, WriteResult, path))
+        .def_ro("success", &BitmapWriter::WriteResult::success, D_NA(BitmapWriter, WriteResult, success))
+        .def_ro("error", &BitmapWriter::WriteResult::error, D_NA(BitmapWriter, WriteResult, error));
+
+    bitmap_writer //
+        .def(
+            nb::init<std::optional<BitmapWriter::Options>>(),
+            "options"_a.none() = nb::none(),
+            D_NA(BitmapWriter, BitmapWriter)
+        )
+        .def_prop_ro("options", &BitmapWriter::options, D_NA(BitmapWriter, options))
+        .def(
+            "write",
+            &BitmapWriter::write,
+            nb::call_guard<nb::gil_scoped_release>(),
+            "bitmap"_a,
+            "path"_a,
+            "format"_a = Bitmap::FileFormat::auto_,
+            "quality"_a = -1,
+            "callback"_a.none() = nb::none(),
+            D_NA(BitmapWriter, write)
+        )
+        .def("flush", &BitmapWriter::flush, nb::call_guard<nb::gil_scoped_release>(), D_NA(BitmapWriter, flush))
+        .def_prop_ro("pending_count", &BitmapWriter::pending_count, D_NA(BitmapWriter, pending_count))
+        .def_prop_ro("pending_bytes", &BitmapWriter::pending_bytes, D_NA(BitmapWriter, pending_bytes))
+        .def_prop_ro("dropped_count", &BitmapWriter::dropped_count, D_NA(BitmapWriter, dropped_count))
+        .def_prop_ro("failed_count", &BitmapWriter::failed_count, D_NA(BitmapWriter, failed_count));
 }
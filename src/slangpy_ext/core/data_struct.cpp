@@ -89,19 +89,40 @@ SGL_PY_EXPORT(core_data_struct)
         .def_static("is_signed", &DataStruct::is_signed, D(DataStruct, is_signed))
         .def_static("is_float", &DataStruct::is_float, D(DataStruct, is_float));
 
-    nb::class_<DataStructConverter, Object>(m, "DataStructConverter", D(DataStructConverter))
+    nb::class_<DataStructConverter, Object> converter(m, "DataStructConverter", D(DataStructConverter));
+
+    nb::sgl_enum<DataStructConverter::Backend>(converter, "Backend", D_NA(DataStructConverter, Backend));
+
+    converter
         .def(
             "__init__",
-            [](DataStructConverter* self, const DataStruct* src, const DataStruct* dst)
+            [](DataStructConverter* self,
+               const DataStruct* src,
+               const DataStruct* dst,
+               DataStructConverter::Backend backend)
             {
-                new (self) DataStructConverter(ref<const DataStruct>(src), ref<const DataStruct>(dst));
+                new (self) DataStructConverter(ref<const DataStruct>(src), ref<const DataStruct>(dst), backend);
             },
             "src"_a,
             "dst"_a,
+            "backend"_a = DataStructConverter::Backend::automatic,
             D(DataStructConverter, DataStructConverter)
         )
         .def_prop_ro("src", &DataStructConverter::src, D(DataStructConverter, src))
         .def_prop_ro("dst", &DataStructConverter::dst, D(DataStructConverter, dst))
+        .def_prop_ro("backend", &DataStructConverter::backend, D_NA(DataStructConverter, backend))
+        .def_prop_rw(
+            "min_grain_size",
+            &DataStructConverter::min_grain_size,
+            &DataStructConverter::set_min_grain_size,
+            D_NA(DataStructConverter, min_grain_size)
+        )
+        .def_prop_rw(
+            "parallel",
+            &DataStructConverter::parallel,
+            &DataStructConverter::set_parallel,
+            D_NA(DataStructConverter, parallel)
+        )
         .def(
             "convert",
             [](DataStructConverter* self, nb::bytes input) -> nb::bytes
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "nanobind.h"
+
+#include "sgl/core/lmdb_cache.h"
+
+namespace sgl {
+using LMDBCacheOptions = LMDBCache::Options;
+SGL_DICT_TO_DESC_BEGIN(LMDBCacheOptions)
+SGL_DICT_TO_DESC_FIELD(max_size, size_t)
+SGL_DICT_TO_DESC_FIELD(eviction_threshold, uint32_t)
+SGL_DICT_TO_DESC_FIELD(eviction_target, uint32_t)
+SGL_DICT_TO_DESC_FIELD(background_eviction, bool)
+SGL_DICT_TO_DESC_FIELD(eviction_sample_size, uint32_t)
+SGL_DICT_TO_DESC_FIELD(nosync, bool)
+SGL_DICT_TO_DESC_FIELD(access_buffer_size, uint32_t)
+SGL_DICT_TO_DESC_FIELD(access_flush_interval_ms, uint32_t)
+SGL_DICT_TO_DESC_END()
+} // namespace sgl
+
+SGL_PY_EXPORT(core_lmdb_cache)
+{
+    using namespace sgl;
+
+    nb::class_<LMDBCache, Object> lmdb_cache(m, "LMDBCache", D_NA(LMDBCache));
+
+    nb::class_<LMDBCache::Options>(lmdb_cache, "Options", D_NA(LMDBCache, Options))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](LMDBCache::Options* self, nb::dict dict)
+            {
+                new (self) LMDBCache::Options(dict_to_LMDBCacheOptions(dict));
+            }
+        )
+        .def_rw("max_size", &LMDBCache::Options::max_size, D_NA(LMDBCache, Options, max_size))
+        .def_rw(
+            "eviction_threshold",
+            &LMDBCache::Options::eviction_threshold,
+            D_NA(LMDBCache, Options, eviction_threshold)
+        )
+        .def_rw("eviction_target", &LMDBCache::Options::eviction_target, D_NA(LMDBCache, Options, eviction_target))
+        .def_rw(
+            "background_eviction",
+            &LMDBCache::Options::background_eviction,
+            D_NA(LMDBCache, Options, background_eviction)
+        )
+        .def_rw(
+            "eviction_sample_size",
+            &LMDBCache::Options::eviction_sample_size,
+            D_NA(LMDBCache, Options, eviction_sample_size)
+        )
+        .def_rw("nosync", &LMDBCache::Options::nosync, D_NA(LMDBCache, Options, nosync))
+        .def_rw(
+            "access_buffer_size",
+            &LMDBCache::Options::access_buffer_size,
+            D_NA(LMDBCache, Options, access_buffer_size)
+        )
+        .def_rw(
+            "access_flush_interval_ms",
+            &LMDBCache::Options::access_flush_interval_ms,
+            D_NA(LMDBCache, Options, access_flush_interval_ms)
+        );
+
+    nb::implicitly_convertible<nb::dict, LMDBCache::Options>();
+
+    nb::class_<LMDBCache::Stats>(lmdb_cache, "Stats", D_NA(LMDBCache, Stats))
+        .def_ro("entries", &LMDBCache::Stats::entries, D_NA(LMDBCache, Stats, entries))
+        .def_ro("size", &LMDBCache::Stats::size, D_NA(LMDBCache, Stats, size))
+        .def_ro("evictions", &LMDBCache::Stats::evictions, D_NA(LMDBCache, Stats, evictions))
+        .def_ro("last_txn_id", &LMDBCache::Stats::last_txn_id, D_NA(LMDBCache, Stats, last_txn_id));
+
+    lmdb_cache //
+        .def(
+            nb::init<const std::filesystem::path&, std::optional<LMDBCache::Options>>(),
+            "path"_a,
+            "options"_a.none() = nb::none(),
+            D_NA(LMDBCache, LMDBCache)
+        )
+        .def(
+            "set",
+            [](LMDBCache* self, nb::bytes key, nb::bytes value)
+            {
+                self->set(key.c_str(), key.size(), value.c_str(), value.size());
+            },
+            "key"_a,
+            "value"_a,
+            D_NA(LMDBCache, set)
+        )
+        .def(
+            "get",
+            [](LMDBCache* self, nb::bytes key) -> std::optional<nb::bytes>
+            {
+                std::optional<nb::bytes> result;
+                self->get(
+                    key.c_str(),
+                    key.size(),
+                    [](const void* data, size_t size, void* user_data)
+                    {
+                        *static_cast<std::optional<nb::bytes>*>(user_data)
+                            = nb::bytes(static_cast<const char*>(data), size);
+                    },
+                    &result
+                );
+                return result;
+            },
+            "key"_a,
+            D_NA(LMDBCache, get)
+        )
+        .def(
+            "delete",
+            [](LMDBCache* self, nb::bytes key)
+            {
+                return self->del(key.c_str(), key.size());
+            },
+            "key"_a,
+            D_NA(LMDBCache, del)
+        )
+        .def("flush", &LMDBCache::flush, D_NA(LMDBCache, flush))
+        .def_prop_ro("stats", &LMDBCache::stats, D_NA(LMDBCache, stats));
+}
@@ -22,6 +22,22 @@ SGL_PY_EXPORT(core_object)
         {
             nb::gil_scoped_acquire guard;
             return Py_REFCNT(o);
+        },
+        []() noexcept -> int
+        {
+            return static_cast<int>(PyGILState_Ensure());
+        },
+        [](int state) noexcept
+        {
+            PyGILState_Release(static_cast<PyGILState_STATE>(state));
+        },
+        []() noexcept -> void*
+        {
+            return PyGILState_Check() ? PyEval_SaveThread() : nullptr;
+        },
+        [](void* state) noexcept
+        {
+            PyEval_RestoreThread(static_cast<PyThreadState*>(state));
         }
     );
 
@@ -16,6 +16,7 @@
 #include "sgl/device/shader.h"
 #include "sgl/device/command.h"
 #include "sgl/device/hot_reload.h"
+#include "sgl/device/buffer_pool.h"
 
 #include "sgl/core/window.h"
 
@@ -286,7 +287,27 @@ SGL_PY_EXPORT(device_device)
         .def_ro("hit_count", &ShaderCacheStats::hit_count, D(ShaderCacheStats, hit_count))
         .def_ro("miss_count", &ShaderCacheStats::miss_count, D(ShaderCacheStats, miss_count));
 
-    nb::class_<ShaderHotReloadEvent>(m, "ShaderHotReloadEvent", D(ShaderHotReloadEvent));
+    nb::class_<BufferPoolStats>(m, "BufferPoolStats", D_NA(BufferPoolStats))
+        .def_ro("hit_count", &BufferPoolStats::hit_count, D_NA(BufferPoolStats, hit_count))
+        .def_ro("miss_count", &BufferPoolStats::miss_count, D_NA(BufferPoolStats, miss_count))
+        .def_ro("used_count", &BufferPoolStats::used_count, D_NA(BufferPoolStats, used_count))
+        .def_ro("free_count", &BufferPoolStats::free_count, D_NA(BufferPoolStats, free_count))
+        .def_ro("free_size", &BufferPoolStats::free_size, D_NA(BufferPoolStats, free_size));
+
+    nb::class_<BufferPool, Object>(m, "BufferPool", D_NA(BufferPool))
+        .def("clear", &BufferPool::clear, D_NA(BufferPool, clear))
+        .def_prop_rw("enabled", &BufferPool::enabled, &BufferPool::set_enabled, D_NA(BufferPool, enabled))
+        .def_prop_rw(
+            "max_free_size",
+            &BufferPool::max_free_size,
+            &BufferPool::set_max_free_size,
+            D_NA(BufferPool, max_free_size)
+        )
+        .def_prop_ro("stats", &BufferPool::stats, D_NA(BufferPool, stats));
+
+    nb::class_<ShaderHotReloadEvent>(m, "ShaderHotReloadEvent", D(ShaderHotReloadEvent))
+        .def_ro("sessions", &ShaderHotReloadEvent::sessions, D_NA(ShaderHotReloadEvent, sessions))
+        .def_ro("changed_files", &ShaderHotReloadEvent::changed_files, D_NA(ShaderHotReloadEvent, changed_files));
 
     nb::class_<HeapReport>(m, "HeapReport", D_NA(HeapReport))
         .def_rw("label", &HeapReport::label, D_NA(HeapReport, label))
@@ -352,6 +373,8 @@ SGL_PY_EXPORT(device_device)
     device.def_prop_ro("desc", &Device::desc, D(Device, desc));
     device.def_prop_ro("info", &Device::info, D(Device, info));
     device.def_prop_ro("shader_cache_stats", &Device::shader_cache_stats, D(Device, shader_cache_stats));
+    device.def_prop_ro("buffer_pool", &Device::buffer_pool, D_NA(Device, buffer_pool));
+    device.def_prop_ro("buffer_pool_stats", &Device::buffer_pool_stats, D_NA(Device, buffer_pool_stats));
     device.def_prop_ro("supported_shader_model", &Device::supported_shader_model, D(Device, supported_shader_model));
     device.def_prop_ro("features", &Device::features, D(Device, features));
     device.def_prop_ro("capabilities", &Device::capabilities, D_NA(Device, capabilities));
@@ -659,6 +682,7 @@ SGL_PY_EXPORT(device_device)
         "cuda_stream"_a = NativeHandle(),
         D(Device, submit_command_buffer)
     );
+    device.def_prop_ro("last_submit_id", &Device::last_submit_id, D_NA(Device, last_submit_id));
     device.def("is_submit_finished", &Device::is_submit_finished, "id"_a, D(Device, is_submit_finished));
     device.def("wait_for_submit", &Device::wait_for_submit, "id"_a, D(Device, wait_for_submit));
     device
@@ -816,13 +840,20 @@ SGL_PY_EXPORT(device_device)
         D(Device, create_slang_session)
     );
     device.def("reload_all_programs", &Device::reload_all_programs, D(Device, reload_all_programs));
-    device.def("load_module", &Device::load_module, "module_name"_a, D(Device, load_module));
+    device.def(
+        "load_module",
+        &Device::load_module,
+        "module_name"_a,
+        nb::call_guard<nb::gil_scoped_release>(),
+        D(Device, load_module)
+    );
     device.def(
         "load_module_from_source",
         &Device::load_module_from_source,
         "module_name"_a,
         "source"_a,
         "path"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, load_module_from_source)
     );
     device.def(
@@ -831,6 +862,7 @@ SGL_PY_EXPORT(device_device)
         "modules"_a,
         "entry_points"_a,
         "link_options"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, link_program)
     );
     device.def(
@@ -840,6 +872,7 @@ SGL_PY_EXPORT(device_device)
         "entry_point_names"_a,
         "additional_source"_a.none() = nb::none(),
         "link_options"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, load_program)
     );
 
@@ -878,10 +911,23 @@ SGL_PY_EXPORT(device_device)
         "program"_a,
         "defer_target_compilation"_a = ComputePipelineDesc().defer_target_compilation,
         "label"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, create_compute_pipeline)
     );
-    device
-        .def("create_compute_pipeline", &Device::create_compute_pipeline, "desc"_a, D(Device, create_compute_pipeline));
+    device.def(
+        "create_compute_pipeline",
+        &Device::create_compute_pipeline,
+        "desc"_a,
+        nb::call_guard<nb::gil_scoped_release>(),
+        D(Device, create_compute_pipeline)
+    );
+    device.def(
+        "create_compute_pipelines",
+        &Device::create_compute_pipelines,
+        "descs"_a,
+        nb::call_guard<nb::gil_scoped_release>(),
+        D_NA(Device, create_compute_pipelines)
+    );
 
     device.def(
         "create_render_pipeline",
@@ -917,9 +963,16 @@ SGL_PY_EXPORT(device_device)
         "multisample"_a.none() = nb::none(),
         "defer_target_compilation"_a = RenderPipelineDesc().defer_target_compilation,
         "label"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
+        D(Device, create_render_pipeline)
+    );
+    device.def(
+        "create_render_pipeline",
+        &Device::create_render_pipeline,
+        "desc"_a,
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, create_render_pipeline)
     );
-    device.def("create_render_pipeline", &Device::create_render_pipeline, "desc"_a, D(Device, create_render_pipeline));
 
     device.def(
         "create_ray_tracing_pipeline",
@@ -952,12 +1005,14 @@ SGL_PY_EXPORT(device_device)
         "flags"_a = RayTracingPipelineDesc().flags,
         "defer_target_compilation"_a = RayTracingPipelineDesc().defer_target_compilation,
         "label"_a.none() = nb::none(),
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, create_ray_tracing_pipeline)
     );
     device.def(
         "create_ray_tracing_pipeline",
         &Device::create_ray_tracing_pipeline,
         "desc"_a,
+        nb::call_guard<nb::gil_scoped_release>(),
         D(Device, create_ray_tracing_pipeline)
     );
 
@@ -458,6 +458,12 @@ SGL_PY_EXPORT(device_raytracing)
             "instances"_a,
             D(AccelerationStructureInstanceList, write, 2)
         )
+        .def(
+            "update",
+            &AccelerationStructureInstanceList::update,
+            "command_encoder"_a,
+            D_NA(AccelerationStructureInstanceList, update)
+        )
         .def("buffer", &AccelerationStructureInstanceList::buffer, D(AccelerationStructureInstanceList, buffer))
         .def(
             "build_input_instances",
@@ -38,6 +38,13 @@ SGL_DICT_TO_DESC_FIELD(dump_intermediates, bool)
 SGL_DICT_TO_DESC_FIELD(dump_intermediates_prefix, std::string)
 SGL_DICT_TO_DESC_END()
 
+SGL_DICT_TO_DESC_BEGIN(ShaderProgramDesc)
+SGL_DICT_TO_DESC_FIELD_LIST(modules, ref<SlangModule>)
+SGL_DICT_TO_DESC_FIELD_LIST(entry_points, ref<SlangEntryPoint>)
+SGL_DICT_TO_DESC_FIELD(link_options, SlangLinkOptions)
+SGL_DICT_TO_DESC_FIELD(label, std::string)
+SGL_DICT_TO_DESC_END()
+
 SGL_DICT_TO_DESC_BEGIN(SlangSessionDesc)
 SGL_DICT_TO_DESC_FIELD(compiler_options, SlangCompilerOptions)
 SGL_DICT_TO_DESC_FIELD(add_default_include_paths, bool)
@@ -192,23 +199,56 @@ SGL_PY_EXPORT(device_shader)
     nb::class_<SlangSession, Object>(m, "SlangSession", D(SlangSession))
         .def_prop_ro("device", &SlangSession::device, D(SlangSession, device))
         .def_prop_ro("desc", &SlangSession::desc, D(SlangSession, desc))
-        .def("load_module", &SlangSession::load_module, "module_name"_a, D(SlangSession, load_module))
+        .def_prop_ro("uid", &SlangSession::uid, D_NA(SlangSession, uid))
+        .def(
+            "load_module",
+            &SlangSession::load_module,
+            "module_name"_a,
+            nb::call_guard<nb::gil_scoped_release>(),
+            D(SlangSession, load_module)
+        )
         .def(
             "load_module_from_source",
             &SlangSession::load_module_from_source,
             "module_name"_a,
             "source"_a,
             "path"_a.none() = nb::none(),
+            nb::call_guard<nb::gil_scoped_release>(),
             D(SlangSession, load_module_from_source)
         )
+        .def(
+            "load_module_from_serialized",
+            [](SlangSession* self, std::string_view module_name, nb::bytes serialized, std::string_view source)
+            {
+                // The serialized data is kept alive by the caller.
+                nb::gil_scoped_release guard;
+                return self->load_module_from_serialized(
+                    module_name,
+                    std::span(reinterpret_cast<const uint8_t*>(serialized.c_str()), serialized.size()),
+                    source
+                );
+            },
+            "module_name"_a,
+            "serialized"_a,
+            "source"_a,
+            D_NA(SlangSession, load_module_from_serialized)
+        )
         .def(
             "link_program",
             &SlangSession::link_program,
             "modules"_a,
             "entry_points"_a,
             "link_options"_a.none() = nb::none(),
+            nb::call_guard<nb::gil_scoped_release>(),
             D(SlangSession, link_program)
         )
+        .def(
+            "link_programs",
+            &SlangSession::link_programs,
+            "descs"_a,
+            nb::call_guard<nb::gil_scoped_release>(),
+            D_NA(SlangSession, link_programs)
+        )
         .def(
             "load_program",
             &SlangSession::load_program,
@@ -216,6 +256,7 @@ SGL_PY_EXPORT(device_shader)
             "entry_point_names"_a,
             "additional_source"_a.none() = nb::none(),
             "link_options"_a.none() = nb::none(),
+            nb::call_guard<nb::gil_scoped_release>(),
             D(SlangSession, load_program)
         )
         .def("load_source", &SlangSession::load_source, "module_name"_a, D(SlangSession, load_source));
@@ -226,12 +267,23 @@ SGL_PY_EXPORT(device_shader)
         .def_prop_ro("path", &SlangModule::path, D(SlangModule, path))
         .def_prop_ro("layout", &SlangModule::layout, D(SlangModule, layout))
         .def_prop_ro("entry_points", &SlangModule::entry_points, D(SlangModule, entry_points))
+        .def_prop_ro("dependencies", &SlangModule::dependencies, D_NA(SlangModule, dependencies))
+        .def(
+            "serialize",
+            [](SlangModule* self)
+            {
+                std::vector<uint8_t> data = self->serialize();
+                return nb::bytes(reinterpret_cast<const char*>(data.data()), data.size());
+            },
+            D_NA(SlangModule, serialize)
+        )
         .def_prop_ro("module_decl", &SlangModule::module_decl, D(SlangModule, module_decl))
         .def(
             "entry_point",
             &SlangModule::entry_point,
             "name"_a,
             "type_conformances"_a = std::span<TypeConformance>(),
+            nb::call_guard<nb::gil_scoped_release>(),
             D(SlangModule, entry_point)
         );
 
@@ -242,7 +294,28 @@ SGL_PY_EXPORT(device_shader)
         .def("rename", &SlangEntryPoint::rename, "new_name"_a, D(SlangEntryPoint, rename))
         .def("with_name", &SlangEntryPoint::with_name, "new_name"_a, D(SlangEntryPoint, with_name));
 
+    nb::class_<ShaderProgramDesc>(m, "ShaderProgramDesc", D_NA(ShaderProgramDesc))
+        .def(nb::init<>())
+        .def(
+            "__init__",
+            [](ShaderProgramDesc* self, nb::dict dict)
+            {
+                new (self) ShaderProgramDesc(dict_to_ShaderProgramDesc(dict));
+            }
+        )
+        .def_rw("modules", &ShaderProgramDesc::modules, D_NA(ShaderProgramDesc, modules))
+        .def_rw("entry_points", &ShaderProgramDesc::entry_points, D_NA(ShaderProgramDesc, entry_points))
+        .def_rw("link_options", &ShaderProgramDesc::link_options, nb::none(), D_NA(ShaderProgramDesc, link_options))
+        .def_rw("label", &ShaderProgramDesc::label, D_NA(ShaderProgramDesc, label));
+    nb::implicitly_convertible<nb::dict, ShaderProgramDesc>();
+
     nb::class_<ShaderProgram, DeviceChild>(m, "ShaderProgram", D(ShaderProgram))
         .def_prop_ro("layout", &ShaderProgram::layout, D(ShaderProgram, layout))
+        .def(
+            "generate_target_code",
+            &ShaderProgram::generate_target_code,
+            nb::call_guard<nb::gil_scoped_release>(),
+            D_NA(ShaderProgram, generate_target_code)
+        )
         .def_prop_ro("reflection", &ShaderProgram::reflection, D(ShaderProgram, reflection));
 }
@@ -611,7 +611,8 @@ static const char *__doc_sgl_Bitmap_read_jpg = R"doc()doc";
 
 static const char *__doc_sgl_Bitmap_read_multiple =
 R"doc(Load a list of bitmaps from multiple paths. Uses multi-threading to
-load bitmaps in parallel.)doc";
+load bitmaps in parallel. Each bitmap is decoded and converted on a
+single thread.)doc";
 
 static const char *__doc_sgl_Bitmap_read_png = R"doc()doc";
 
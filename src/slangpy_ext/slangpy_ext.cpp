@@ -16,6 +16,7 @@ SGL_PY_DECLARE(core_crypto);
 SGL_PY_DECLARE(core_data_struct);
 SGL_PY_DECLARE(core_data_type);
 SGL_PY_DECLARE(core_input);
+SGL_PY_DECLARE(core_lmdb_cache);
 SGL_PY_DECLARE(core_logger);
 SGL_PY_DECLARE(core_object);
 SGL_PY_DECLARE(core_platform);
@@ -108,6 +109,7 @@ NB_MODULE(slangpy_ext, m_)
     SGL_PY_IMPORT(core_data_struct);
     SGL_PY_IMPORT(core_bitmap);
     SGL_PY_IMPORT(core_crypto);
+    SGL_PY_IMPORT(core_lmdb_cache);
     SGL_PY_IMPORT(core_data_type);
 
     SGL_PY_IMPORT(math_scalar);
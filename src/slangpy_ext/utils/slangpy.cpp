@@ -106,6 +106,37 @@ std::string SignatureBuilder::str() const
     return std::string(reinterpret_cast<const char*>(m_buffer), m_size);
 }
 
+ShaderCursor CursorWritePlan::field(const ShaderCursor& parent, std::string_view name)
+{
+    // Replay a recorded location if this field was already resolved for the parent's layout.
+    slang::TypeLayoutReflection* parent_type_layout = parent.slang_type_layout();
+    for (const Entry& entry : m_entries) {
+        if (entry.parent_type_layout == parent_type_layout && entry.name == name) {
+            ShaderOffset offset = parent.offset();
+            offset.uniform_offset += entry.uniform_offset;
+            offset.binding_range_index += entry.binding_range_offset;
+            return ShaderCursor(parent.shader_object(), entry.type_layout, offset);
+        }
+    }
+
+    // Resolve through reflection.
+    ShaderCursor result = parent[name];
+
+    // Only record fields that live in the same shader object as their parent. Looking up
+    // a field through a constant buffer or parameter block dereferences into a sub-object,
+    // which has to be fetched again for every dispatch.
+    if (result.shader_object() == parent.shader_object()) {
+        m_entries.push_back({
+            .parent_type_layout = parent_type_layout,
+            .name = std::string(name),
+            .type_layout = result.slang_type_layout(),
+            .uniform_offset = result.offset().uniform_offset - parent.offset().uniform_offset,
+            .binding_range_offset = result.offset().binding_range_index - parent.offset().binding_range_index,
+        });
+    }
+    return result;
+}
+
 void NativeMarshall::write_shader_cursor_pre_dispatch(
     CallContext* context,
     NativeBoundVariableRuntime* binding,
@@ -117,7 +148,7 @@ void NativeMarshall::write_shader_cursor_pre_dispatch(
     // We are a leaf node, so generate and store call data for this node.
     nb::object cd_val = create_calldata(context, binding, value);
     if (!cd_val.is_none()) {
-        ShaderCursor child_field = cursor[binding->variable_name()];
+        ShaderCursor child_field = binding->resolve_field(cursor, binding->variable_name());
         write_shader_cursor(child_field, cd_val);
         store_readback(binding, read_back, value, cd_val);
     }
@@ -227,12 +258,12 @@ void NativeBoundVariableRuntime::write_shader_cursor_pre_dispatch(
     if (is_param_block()) {
         // This variable is represented as a fixed parameter block so just
         // write it straight in.
-        auto pb_cursor = cursor[m_variable_name.c_str()];
+        auto pb_cursor = resolve_field(cursor, m_variable_name);
         write_shader_cursor(pb_cursor, value);
     } else if (m_children) {
         // We have children, so generate call data for each child and
         // store in a dictionary, then store the dictionary as the call data.
-        ShaderCursor child_field = cursor[m_variable_name.c_str()];
+        ShaderCursor child_field = resolve_field(cursor, m_variable_name);
         for (const auto& [name, child_ref] : *m_children) {
             if (child_ref) {
                 nb::object child_value = value[name.c_str()];
@@ -428,20 +459,82 @@ nb::object NativeCallData::exec(
     nb::args args,
     nb::kwargs kwargs
 )
+{
+    NativeCallDispatch dispatch;
+    dispatch.opts = std::move(opts);
+    dispatch.args = args;
+    dispatch.kwargs = kwargs;
+    prepare_dispatch(dispatch, command_encoder != nullptr);
+
+    // If CUDA stream is provided, check for valid use and sync device to the CUDA stream
+    NativeHandle cuda_stream = dispatch.opts->cuda_stream();
+    if (cuda_stream.is_valid()) {
+        SGL_CHECK(command_encoder == nullptr, "Cannot specify a CUDA stream when appending to a command encoder.");
+        SGL_CHECK(
+            m_device->supports_cuda_interop() || m_device->type() == DeviceType::cuda,
+            "To specify a CUDA stream, device must be either using CUDA backend or have CUDA interop enabled."
+        );
+    }
+
+    // Create temporary command encoder if none is provided.
+    ref<CommandEncoder> temp_command_encoder;
+    if (command_encoder == nullptr) {
+        temp_command_encoder = m_device->create_command_encoder();
+        command_encoder = temp_command_encoder.get();
+    }
+
+    bool is_ray_tracing = dispatch.opts->is_ray_tracing();
+
+    if (!is_ray_tracing) {
+        ref<ComputePassEncoder> pass_encoder = command_encoder->begin_compute_pass();
+        ComputePipeline* pipeline = dynamic_cast<ComputePipeline*>(m_pipeline.get());
+        SGL_ASSERT(pipeline != nullptr);
+        ShaderCursor cursor(pass_encoder->bind_pipeline(pipeline));
+        bind_call_data(dispatch, cursor);
+        pass_encoder->dispatch(uint3(dispatch.total_threads, 1, 1));
+        pass_encoder->end();
+    } else {
+        ref<RayTracingPassEncoder> pass_encoder = command_encoder->begin_ray_tracing_pass();
+        RayTracingPipeline* pipeline = dynamic_cast<RayTracingPipeline*>(m_pipeline.get());
+        SGL_ASSERT(pipeline != nullptr);
+        ShaderCursor cursor(pass_encoder->bind_pipeline(pipeline, m_shader_table));
+        bind_call_data(dispatch, cursor);
+        pass_encoder->dispatch_rays(0, uint3(dispatch.total_threads, 1, 1));
+        pass_encoder->end();
+    }
+
+    // If we created a temporary command encoder, we need to submit it.
+    if (temp_command_encoder) {
+        m_device->submit_command_buffer(temp_command_encoder->finish(), CommandQueueType::graphics, cuda_stream);
+        command_encoder = nullptr;
+    }
+
+    // If command_encoder is not null, return early.
+    if (command_encoder != nullptr) {
+        return nanobind::none();
+    }
+
+    return finish_dispatch(dispatch);
+}
+
+void NativeCallData::prepare_dispatch(NativeCallDispatch& dispatch, bool is_append)
 {
     // Unpack args and kwargs.
-    nb::list unpacked_args = unpack_args(args);
-    nb::dict unpacked_kwargs = unpack_kwargs(kwargs);
+    dispatch.unpacked_args = unpack_args(dispatch.args);
+    dispatch.unpacked_kwargs = unpack_kwargs(dispatch.kwargs);
+    nb::kwargs& kwargs = dispatch.kwargs;
+    nb::dict& unpacked_kwargs = dispatch.unpacked_kwargs;
 
     // Calculate call shape.
-    Shape call_shape = m_runtime->calculate_call_shape(m_call_dimensionality, unpacked_args, unpacked_kwargs, this);
+    Shape call_shape
+        = m_runtime->calculate_call_shape(m_call_dimensionality, dispatch.unpacked_args, unpacked_kwargs, this);
     m_last_call_shape = call_shape;
 
     // Setup context.
     auto context = make_ref<CallContext>(m_device, call_shape, m_call_mode);
 
     // Allocate return value if needed.
-    if (!command_encoder && m_call_mode == CallMode::prim) {
+    if (!is_append && m_call_mode == CallMode::prim) {
         ref<NativeBoundVariableRuntime> rv_node = m_runtime->find_kwarg("_result");
         if (rv_node && (!kwargs.contains("_result") || kwargs["_result"].is_none())) {
             nb::object output = rv_node->python_type()->create_output(context, rv_node.get());
@@ -550,7 +643,7 @@ nb::object NativeCallData::exec(
     //       which would likely defeat the purpose of using call groups for better
     //       memory coherency and uses of shared memory.
     int total_threads = 1;
-    short_vector<int, 32> call_grid_shape;
+    short_vector<int, 32>& call_grid_shape = dispatch.call_grid_shape;
     short_vector<int, 32> aligned_call_shape;
     bool is_call_shape_unaligned = false;
     for (int i = 0; i < cs.size(); i++) {
@@ -564,19 +657,17 @@ nb::object NativeCallData::exec(
     }
 
     // Calculate the grid strides
-    short_vector<int, 32> call_grid_strides;
+    short_vector<int, 32>& call_grid_strides = dispatch.call_grid_strides;
     current_stride = 1;
-    for (auto it = call_grid_shape.end() - 1; it >= call_grid_shape.begin(); --it) {
+    for (size_t i = call_grid_shape.size(); i-- > 0;) {
         call_grid_strides.push_back(current_stride);
-        current_stride *= *it;
+        current_stride *= call_grid_shape[i];
     }
     std::reverse(call_grid_strides.begin(), call_grid_strides.end());
 
-    nb::list read_back;
-
     if (is_log_enabled(LogLevel::debug)) {
         log_debug("Dispatching {}", m_debug_name);
-        log_debug("  Call type: {}", command_encoder ? "append" : "call");
+        log_debug("  Call type: {}", is_append ? "append" : "call");
         log_debug("  Call shape: {}", call_shape.to_string());
         log_debug("  Call mode: {}", m_call_mode);
         log_debug("  Strides: [{}]", fmt::join(strides, ", "));
@@ -593,114 +684,83 @@ nb::object NativeCallData::exec(
         log_debug("  Threads: {}", total_threads);
     }
 
-    // If CUDA stream is provided, check for valid use and sync device to the CUDA stream
-    NativeHandle cuda_stream = opts->cuda_stream();
-    if (cuda_stream.is_valid()) {
-        SGL_CHECK(command_encoder == nullptr, "Cannot specify a CUDA stream when appending to a command encoder.");
-        SGL_CHECK(
-            m_device->supports_cuda_interop() || m_device->type() == DeviceType::cuda,
-            "To specify a CUDA stream, device must be either using CUDA backend or have CUDA interop enabled."
-        );
-    }
+    dispatch.context = std::move(context);
+    dispatch.call_shape = std::move(call_shape);
+    dispatch.total_threads = total_threads;
+}
 
-    auto bind_call_data = [&](ShaderCursor cursor)
-    {
-        // Get the call data cursor, either as an entry point parameter or global depending on call data mode
-        ShaderCursor call_data_cursor;
-        if (m_call_data_mode == CallDataMode::entry_point) {
-            call_data_cursor = cursor.find_entry_point(0).find_field("call_data");
-        } else {
-            call_data_cursor = cursor.find_field("call_data");
-        }
+void NativeCallData::bind_call_data(NativeCallDispatch& dispatch, ShaderCursor cursor)
+{
+    const std::vector<int>& cs = dispatch.call_shape.as_vector();
+
+    // Get the call data cursor, either as an entry point parameter or global depending on call data mode.
+    // Field lookups go through the write plan, which records the resolved offsets on
+    // the first dispatch and replays them afterwards.
+    ShaderCursor call_data_cursor;
+    if (m_call_data_mode == CallDataMode::entry_point) {
+        call_data_cursor = m_write_plan.field(cursor.find_entry_point(0), "call_data");
+    } else {
+        call_data_cursor = m_write_plan.field(cursor, "call_data");
+    }
 
-        // Dereference the cursor if it is a reference.
-        // We do this here to avoid doing it automatically for every
-        // child. Shouldn't need to do recursively as its only
-        // relevant for parameter blocks and constant buffers.
-        if (call_data_cursor.is_reference())
-            call_data_cursor = call_data_cursor.dereference();
-
-        if (!cs.empty()) {
-            call_data_cursor["_call_dim"]
-                ._set_array_unsafe(&cs[0], cs.size() * 4, cs.size(), TypeReflection::ScalarType::int32);
-            call_data_cursor["_grid_stride"]._set_array_unsafe(
-                &call_grid_strides[0],
-                call_grid_strides.size() * 4,
-                call_grid_strides.size(),
+    // Dereference the cursor if it is a reference.
+    // We do this here to avoid doing it automatically for every
+    // child. Shouldn't need to do recursively as its only
+    // relevant for parameter blocks and constant buffers.
+    if (call_data_cursor.is_reference())
+        call_data_cursor = call_data_cursor.dereference();
+
+    if (!cs.empty()) {
+        m_write_plan.field(call_data_cursor, "_call_dim")
+            ._set_array_unsafe(&cs[0], cs.size() * 4, cs.size(), TypeReflection::ScalarType::int32);
+        m_write_plan.field(call_data_cursor, "_grid_stride")
+            ._set_array_unsafe(
+                &dispatch.call_grid_strides[0],
+                dispatch.call_grid_strides.size() * 4,
+                dispatch.call_grid_strides.size(),
                 TypeReflection::ScalarType::int32
             );
-            call_data_cursor["_grid_dim"]._set_array_unsafe(
-                &call_grid_shape[0],
-                call_grid_shape.size() * 4,
-                call_grid_shape.size(),
+        m_write_plan.field(call_data_cursor, "_grid_dim")
+            ._set_array_unsafe(
+                &dispatch.call_grid_shape[0],
+                dispatch.call_grid_shape.size() * 4,
+                dispatch.call_grid_shape.size(),
                 TypeReflection::ScalarType::int32
             );
-        }
+    }
 
-        call_data_cursor["_thread_count"] = uint3(total_threads, 1, 1);
+    m_write_plan.field(call_data_cursor, "_thread_count") = uint3(dispatch.total_threads, 1, 1);
 
-        m_runtime->write_shader_cursor_pre_dispatch(
-            context,
-            cursor,
-            call_data_cursor,
-            unpacked_args,
-            unpacked_kwargs,
-            read_back
-        );
+    m_runtime->write_shader_cursor_pre_dispatch(
+        dispatch.context,
+        cursor,
+        call_data_cursor,
+        dispatch.unpacked_args,
+        dispatch.unpacked_kwargs,
+        dispatch.read_back
+    );
 
-        nb::list uniforms = opts->uniforms();
-        if (uniforms) {
-            for (auto u : uniforms) {
-                if (nb::isinstance<nb::dict>(u)) {
-                    write_shader_cursor(cursor, nb::cast<nb::dict>(u));
-                } else {
-                    write_shader_cursor(cursor, nb::cast<nb::dict>(u(this)));
-                }
+    nb::list uniforms = dispatch.opts->uniforms();
+    if (uniforms) {
+        for (auto u : uniforms) {
+            if (nb::isinstance<nb::dict>(u)) {
+                write_shader_cursor(cursor, nb::cast<nb::dict>(u));
+            } else {
+                write_shader_cursor(cursor, nb::cast<nb::dict>(u(this)));
             }
         }
-    };
-
-    // Create temporary command encoder if none is provided.
-    ref<CommandEncoder> temp_command_encoder;
-    if (command_encoder == nullptr) {
-        temp_command_encoder = m_device->create_command_encoder();
-        command_encoder = temp_command_encoder.get();
-    }
-
-    bool is_ray_tracing = opts->is_ray_tracing();
-
-    if (!is_ray_tracing) {
-        ref<ComputePassEncoder> pass_encoder = command_encoder->begin_compute_pass();
-        ComputePipeline* pipeline = dynamic_cast<ComputePipeline*>(m_pipeline.get());
-        SGL_ASSERT(pipeline != nullptr);
-        ShaderCursor cursor(pass_encoder->bind_pipeline(pipeline));
-        bind_call_data(cursor);
-        pass_encoder->dispatch(uint3(total_threads, 1, 1));
-        pass_encoder->end();
-    } else {
-        ref<RayTracingPassEncoder> pass_encoder = command_encoder->begin_ray_tracing_pass();
-        RayTracingPipeline* pipeline = dynamic_cast<RayTracingPipeline*>(m_pipeline.get());
-        SGL_ASSERT(pipeline != nullptr);
-        ShaderCursor cursor(pass_encoder->bind_pipeline(pipeline, m_shader_table));
-        bind_call_data(cursor);
-        pass_encoder->dispatch_rays(0, uint3(total_threads, 1, 1));
-        pass_encoder->end();
-    }
-
-    // If we created a temporary command encoder, we need to submit it.
-    if (temp_command_encoder) {
-        m_device->submit_command_buffer(temp_command_encoder->finish(), CommandQueueType::graphics, cuda_stream);
-        command_encoder = nullptr;
     }
+}
 
-    // If command_encoder is not null, return early.
-    if (command_encoder != nullptr) {
-        return nanobind::none();
-    }
+nb::object NativeCallData::finish_dispatch(NativeCallDispatch& dispatch)
+{
+    CallContext* context = dispatch.context;
+    nb::list& unpacked_args = dispatch.unpacked_args;
+    nb::dict& unpacked_kwargs = dispatch.unpacked_kwargs;
 
     // Read call data post dispatch.
     // m_runtime->read_call_data_post_dispatch(context, call_data, unpacked_args, unpacked_kwargs);
-    for (auto val : read_back) {
+    for (auto val : dispatch.read_back) {
         auto t = nb::cast<nb::tuple>(val);
         auto bvr = nb::cast<ref<NativeBoundVariableRuntime>>(t[0]);
         auto rb_val = t[1];
@@ -709,10 +769,10 @@ nb::object NativeCallData::exec(
     }
 
     // Pack updated 'this' values back.
-    for (size_t i = 0; i < args.size(); ++i) {
-        pack_arg(args[i], unpacked_args[i]);
+    for (size_t i = 0; i < dispatch.args.size(); ++i) {
+        pack_arg(dispatch.args[i], unpacked_args[i]);
     }
-    for (auto [k, v] : kwargs) {
+    for (auto [k, v] : dispatch.kwargs) {
         pack_arg(nb::cast<nb::object>(v), unpacked_kwargs[k]);
     }
 
@@ -726,6 +786,78 @@ nb::object NativeCallData::exec(
     return nb::none();
 }
 
+NativeCallBatch::NativeCallBatch(ref<Device> device)
+    : m_device(std::move(device))
+{
+}
+
+size_t NativeCallBatch::add_call(
+    ref<NativeCallData> call_data,
+    ref<NativeCallRuntimeOptions> opts,
+    nb::args args,
+    nb::kwargs kwargs
+)
+{
+    SGL_CHECK(call_data->device() == m_device, "Call data was created for a different device than the batch.");
+    SGL_CHECK(!opts->is_ray_tracing(), "Ray tracing calls cannot be added to a call batch.");
+    SGL_CHECK(
+        !opts->cuda_stream().is_valid(),
+        "Calls in a batch cannot specify a CUDA stream, pass it to submit() instead."
+    );
+
+    // Prepare the dispatch now so that errors are reported against the call that caused them.
+    auto entry = std::make_unique<Entry>();
+    entry->call_data = std::move(call_data);
+    entry->dispatch.opts = std::move(opts);
+    entry->dispatch.args = args;
+    entry->dispatch.kwargs = kwargs;
+    entry->call_data->prepare_dispatch(entry->dispatch, false);
+
+    m_calls.push_back(std::move(entry));
+    return m_calls.size() - 1;
+}
+
+nb::list NativeCallBatch::submit(NativeHandle cuda_stream)
+{
+    if (cuda_stream.is_valid()) {
+        SGL_CHECK(
+            m_device->supports_cuda_interop() || m_device->type() == DeviceType::cuda,
+            "To specify a CUDA stream, device must be either using CUDA backend or have CUDA interop enabled."
+        );
+    }
+
+    // Take ownership of the pending calls so the batch can be reused even if encoding fails.
+    std::vector<std::unique_ptr<Entry>> calls = std::move(m_calls);
+    m_calls.clear();
+
+    nb::list results;
+    if (calls.empty())
+        return results;
+
+    // Encode all calls into a single command encoder, one compute pass per call (as when appending calls to a
+    // command encoder). Calls may read the outputs of previous calls, including data bound by address, which
+    // resource state tracking doesn't cover, so calls are separated by a global barrier.
+    ref<CommandEncoder> command_encoder = m_device->create_command_encoder();
+    for (size_t i = 0; i < calls.size(); ++i) {
+        Entry& entry = *calls[i];
+        if (i > 0)
+            command_encoder->global_barrier();
+        ref<ComputePassEncoder> pass_encoder = command_encoder->begin_compute_pass();
+        ComputePipeline* pipeline = dynamic_cast<ComputePipeline*>(entry.call_data->pipeline().get());
+        SGL_ASSERT(pipeline != nullptr);
+        ShaderCursor cursor(pass_encoder->bind_pipeline(pipeline));
+        entry.call_data->bind_call_data(entry.dispatch, cursor);
+        pass_encoder->dispatch(uint3(entry.dispatch.total_threads, 1, 1));
+        pass_encoder->end();
+    }
+
+    // Submit once, then read back results of all calls.
+    m_device->submit_command_buffer(command_encoder->finish(), CommandQueueType::graphics, cuda_stream);
+    for (const std::unique_ptr<Entry>& entry : calls)
+        results.append(entry->call_data->finish_dispatch(entry->dispatch));
+    return results;
+}
+
 nb::object PyNativeCallData::_py_torch_call(
     NativeFunctionNode* func,
     ref<NativeCallRuntimeOptions> opts,
@@ -738,7 +870,7 @@ nb::object PyNativeCallData::_py_torch_call(
 
 NativeCallDataCache::NativeCallDataCache()
 {
-    m_cache.reserve(1024);
+    m_slots.resize(1024);
 
     m_type_signature_table[typeid(Texture)] = [](const ref<SignatureBuilder>& builder, nb::handle o)
     {
@@ -775,111 +907,244 @@ NativeCallDataCache::NativeCallDataCache()
     };
 }
 
-void NativeCallDataCache::get_value_signature(const ref<SignatureBuilder> builder, nb::handle o)
+size_t NativeCallDataCache::find_slot(const SignatureHash& hash, const uint8_t* data, size_t size) const
 {
-    // Get python type.
-    auto type = o.type();
+    size_t mask = m_slots.size() - 1;
+    size_t index = hash.fold() & mask;
+    while (true) {
+        const Slot& slot = m_slots[index];
+        if (!slot.used)
+            return index;
+        if (slot.hash == hash && slot.signature.size() == size && memcmp(slot.signature.data(), data, size) == 0)
+            return index;
+        index = (index + 1) & mask;
+    }
+}
 
-    // Check if this is a bound native type, in which case we can hopefully do fast things!
-    bool is_bound_type = nb::type_check(type);
-    if (is_bound_type) {
+ref<NativeCallData>
+NativeCallDataCache::find_call_data(const SignatureHash& hash, const uint8_t* data, size_t size) const
+{
+    const Slot& slot = m_slots[find_slot(hash, data, size)];
+    return slot.used ? slot.call_data : nullptr;
+}
+
+void NativeCallDataCache::add_call_data(
+    const SignatureHash& hash,
+    const uint8_t* data,
+    size_t size,
+    const ref<NativeCallData>& call_data
+)
+{
+    Slot& slot = m_slots[find_slot(hash, data, size)];
+    if (slot.used) {
+        slot.call_data = call_data;
+        return;
+    }
+    slot.used = true;
+    slot.hash = hash;
+    slot.signature.assign(reinterpret_cast<const char*>(data), size);
+    slot.call_data = call_data;
+    m_count++;
+
+    // Grow once half full, keeping probe sequences short.
+    if (m_count * 2 > m_slots.size()) {
+        std::vector<Slot> old_slots(m_slots.size() * 2);
+        std::swap(old_slots, m_slots);
+        size_t mask = m_slots.size() - 1;
+        for (Slot& old_slot : old_slots) {
+            if (!old_slot.used)
+                continue;
+            size_t index = old_slot.hash.fold() & mask;
+            while (m_slots[index].used)
+                index = (index + 1) & mask;
+            m_slots[index] = std::move(old_slot);
+        }
+    }
+}
+
+const NativeCallDataCache::ValueTypeInfo& NativeCallDataCache::classify_value_type(nb::handle o)
+{
+    PyTypeObject* type = Py_TYPE(o.ptr());
+
+    // Kinds other than generic objects depend only on the type's bases, so are always valid.
+    // Generic objects also depend on class attributes, so are revalidated against the
+    // type's version tag, which Python resets whenever the type is modified.
+    auto it = m_value_types.find(type);
+    if (it != m_value_types.end()) {
+        const ValueTypeInfo& info = it->second;
+        if (info.kind != ValueKind::object
+            || ((type->tp_flags & Py_TPFLAGS_VALID_VERSION_TAG) && info.version_tag == type->tp_version_tag))
+            return info;
+    }
 
+    nb::handle type_handle(reinterpret_cast<PyObject*>(type));
+    ValueTypeInfo info;
+
+    // Check if this is a bound native type, in which case we can hopefully do fast things!
+    if (nb::type_check(type_handle)) {
         // Get C++ type info, and attempt to cast to a slangpy native object
-        const auto& type_info = nb::type_info(type);
+        const auto& type_info = nb::type_info(type_handle);
 
         // If we have a native object, can directly request the signature.
         const NativeObject* native_object;
         if (nb::try_cast<const NativeObject*>(o, native_object)) {
-            *builder << type_info.name() << "\n";
-            native_object->read_signature(builder);
-            return;
+            info.type = nb::borrow(type_handle);
+            info.kind = ValueKind::native_object;
+            info.type_name = type_info.name();
+            return m_value_types[type] = std::move(info);
         }
 
         // Attempt to use type signature table to lookup type
-        auto it = m_type_signature_table.find(type_info);
-        if (it != m_type_signature_table.end()) {
-            if (it->second(builder, o)) {
-                return;
-            }
-        }
+        auto table_it = m_type_signature_table.find(type_info);
+        if (table_it != m_type_signature_table.end())
+            info.table_func = &table_it->second;
     }
 
-    // Fast path for basic Python types (int/float) here.
     if (nb::isinstance<int>(o)) {
+        info.kind = ValueKind::int_;
+    } else if (nb::isinstance<float>(o)) {
+        info.kind = ValueKind::float_;
+    } else if (nb::isinstance<bool>(o)) {
+        info.kind = ValueKind::bool_;
+    } else if (nb::isinstance<nb::str>(o)) {
+        info.kind = ValueKind::string;
+    } else if (nb::isinstance<nb::tuple>(o)) {
+        info.kind = ValueKind::tuple;
+    } else if (nb::isinstance<nb::list>(o)) {
+        info.kind = ValueKind::list;
+    } else {
+        info.kind = ValueKind::object;
+        info.type_name = nb::str(nb::getattr(type_handle, "__name__")).c_str();
+        info.dynamic_attrs = type->tp_getattro != PyObject_GenericGetAttr;
+        info.instance_dict = type->tp_dictoffset != 0;
+        info.type_get_this = nb::hasattr(type_handle, "get_this");
+        info.type_slangpy_signature = nb::hasattr(type_handle, "slangpy_signature");
+        info.maybe_tensor
+            = info.dynamic_attrs || type->tp_as_buffer != nullptr || nb::hasattr(type_handle, "__dlpack__");
+        info.is_dict = nb::isinstance<nb::dict>(o);
+        // Read after the attribute lookups above, which assign the tag if needed.
+        info.version_tag = type->tp_version_tag;
+    }
+    info.type = nb::borrow(type_handle);
+    return m_value_types[type] = std::move(info);
+}
+
+void NativeCallDataCache::trim_value_types()
+{
+    if (m_value_types.size() > MAX_VALUE_TYPES)
+        m_value_types.clear();
+}
+
+void NativeCallDataCache::get_value_signature(const ref<SignatureBuilder> builder, nb::handle o)
+{
+    trim_value_types();
+    append_value_signature(builder, o);
+}
+
+void NativeCallDataCache::append_value_signature(const ref<SignatureBuilder> builder, nb::handle o)
+{
+    const ValueTypeInfo& info = classify_value_type(o);
+
+    // Type signature table functions can decline a value, in which case it is handled by kind.
+    if (info.table_func && (*info.table_func)(builder, o))
+        return;
+
+    switch (info.kind) {
+    case ValueKind::native_object:
+        *builder << info.type_name << "\n";
+        nb::cast<const NativeObject*>(o)->read_signature(builder);
+        return;
+    case ValueKind::int_:
         *builder << "int\n";
         return;
-    }
-    if (nb::isinstance<float>(o)) {
+    case ValueKind::float_:
         *builder << "float\n";
         return;
-    }
-    if (nb::isinstance<bool>(o)) {
+    case ValueKind::bool_:
         *builder << "bool\n";
         return;
-    }
-    if (nb::isinstance<nb::str>(o)) {
+    case ValueKind::string:
         *builder << "string\n";
         return;
-    }
-
-    // Python tuple/list
-    nb::tuple tuple;
-    if (nb::try_cast<nb::tuple>(o, tuple)) {
+    case ValueKind::tuple:
         *builder << "tuple\n";
-        for (const auto& i : tuple) {
-            get_value_signature(builder, i);
+        for (const auto& i : nb::borrow<nb::tuple>(o)) {
+            append_value_signature(builder, i);
         }
         return;
-    }
-    nb::list list;
-    if (nb::try_cast<nb::list>(o, list)) {
+    case ValueKind::list:
         *builder << "list\n";
-        for (const auto& i : list) {
-            get_value_signature(builder, i);
+        for (const auto& i : nb::borrow<nb::list>(o)) {
+            append_value_signature(builder, i);
         }
         return;
+    case ValueKind::object:
+        break;
     }
 
     // Add type name.
-    auto type_name = nb::str(nb::getattr(o.type(), "__name__"));
-    *builder << type_name.c_str() << "\n";
+    *builder << info.type_name << "\n";
+
+    // Attributes provided by the type (or any attribute of a type with custom lookup) are
+    // read through getattr. Otherwise they can only live in the instance dictionary, which
+    // is checked directly rather than paying for failed attribute lookups.
+    nb::object instance_dict;
+    if (!info.dynamic_attrs && info.instance_dict && !(info.type_get_this && info.type_slangpy_signature)) {
+        PyObject* dict = PyObject_GenericGetDict(o.ptr(), nullptr);
+        if (dict)
+            instance_dict = nb::steal(dict);
+        else
+            PyErr_Clear();
+    }
+    auto find_attr = [&](const char* name, bool on_type) -> nb::object
+    {
+        if (info.dynamic_attrs || on_type)
+            return nb::getattr(o, name, nb::handle());
+        if (instance_dict.is_valid())
+            return nb::borrow(PyDict_GetItemString(instance_dict.ptr(), name));
+        return nb::object();
+    };
 
     // Handle objects with get_this method.
-    auto get_this = nb::getattr(o, "get_this", nb::none());
-    if (!get_this.is_none()) {
+    nb::object get_this = find_attr("get_this", info.type_get_this);
+    if (get_this.is_valid() && !get_this.is_none()) {
         auto this_ = get_this();
-        get_value_signature(builder, this_);
+        append_value_signature(builder, this_);
         return;
     }
 
     // If x has signature attribute, use it.
-    if (nb::hasattr(o, "slangpy_signature")) {
-
-        auto slangpy_sig = nb::getattr(o, "slangpy_signature");
+    nb::object slangpy_sig = find_attr("slangpy_signature", info.type_slangpy_signature);
+    if (slangpy_sig.is_valid()) {
         *builder << nb::str(slangpy_sig).c_str() << "\n";
         return;
     }
 
     // Signature for pytorch tensors
-    {
+    if (info.maybe_tensor) {
         nb::ndarray<nb::pytorch, nb::device::cuda> pytorch_tensor;
         if (nb::try_cast(o, pytorch_tensor)) {
-            *builder << fmt::format(
-                "[torch,D{},C{},B{},L{}]",
-                pytorch_tensor.ndim(),
-                pytorch_tensor.dtype().code,
-                pytorch_tensor.dtype().bits,
-                pytorch_tensor.dtype().lanes
+            // Note: Using snprintf here as fmt library is quite
+            // a bit slower for this use case. (over 4x).
+            char temp[256];
+            std::snprintf(
+                temp,
+                sizeof(temp),
+                "[torch,D%d,C%d,B%d,L%d]",
+                (int)pytorch_tensor.ndim(),
+                (int)pytorch_tensor.dtype().code,
+                (int)pytorch_tensor.dtype().bits,
+                (int)pytorch_tensor.dtype().lanes
             );
+            builder->add(temp);
             return;
         }
     }
 
     // If x is a dictionary get signature of its children.
-    nb::dict dict;
-    if (nb::try_cast(o, dict)) {
+    if (info.is_dict) {
         *builder << "\n";
-        for (const auto& [k, v] : dict) {
+        for (const auto& [k, v] : nb::borrow<nb::dict>(o)) {
             nb::str key(k);
             *builder << key.c_str() << ":";
 
@@ -889,7 +1154,7 @@ void NativeCallDataCache::get_value_signature(const ref<SignatureBuilder> builde
                 // we have to encode the value directly, as it affects type resolution
                 *builder << _type.c_str() << "\n";
             } else {
-                get_value_signature(builder, v);
+                append_value_signature(builder, v);
             }
         }
         return;
@@ -905,17 +1170,19 @@ void NativeCallDataCache::get_value_signature(const ref<SignatureBuilder> builde
 
 void NativeCallDataCache::get_args_signature(const ref<SignatureBuilder> builder, nb::args args, nb::kwargs kwargs)
 {
+    trim_value_types();
+
     builder->add("args\n");
     for (const auto& arg : args) {
         builder->add("N:");
-        get_value_signature(builder, arg);
+        append_value_signature(builder, arg);
     }
 
     builder->add("kwargs\n");
     for (const auto& [k, v] : kwargs) {
         builder->add(nb::str(k).c_str());
         builder->add(":");
-        get_value_signature(builder, v);
+        append_value_signature(builder, v);
     }
 }
 
@@ -1008,9 +1275,10 @@ void pack_arg(nanobind::object arg, nanobind::object unpacked_arg)
 // Helper to get signature of a single value.
 std::string get_value_signature(nb::handle o)
 {
-    static NativeCallDataCache cache;
+    // Intentionally leaked, the cache holds Python types that can't be released after finalization.
+    static NativeCallDataCache* cache = new NativeCallDataCache();
     auto builder = make_ref<SignatureBuilder>();
-    cache.get_value_signature(builder, o);
+    cache->get_value_signature(builder, o);
     return builder->str();
 }
 
@@ -1105,6 +1373,11 @@ SGL_PY_EXPORT(utils_slangpy)
         .def(nb::init<>(), D_NA(SignatureBuilder, SignatureBuilder))
         .def("add", nb::overload_cast<const std::string&>(&SignatureBuilder::add), "value"_a, D_NA(NativeObject, add))
         .def_prop_ro("str", &SignatureBuilder::str, D_NA(SignatureBuilder, str))
+        .def_prop_ro(
+            "hash",
+            [](const SignatureBuilder& self) { return nb::make_tuple(self.hash().lo, self.hash().hi); },
+            D_NA(SignatureBuilder, hash)
+        )
         .def_prop_ro(
             "bytes",
             &SignatureBuilder::bytes,
@@ -1491,17 +1764,33 @@ SGL_PY_EXPORT(utils_slangpy)
         )
         .def(
             "find_call_data",
-            &NativeCallDataCache::find_call_data,
+            nb::overload_cast<const std::string&>(&NativeCallDataCache::find_call_data, nb::const_),
             "signature"_a,
             D_NA(NativeCallDataCache, find_call_data)
         )
+        .def(
+            "find_call_data",
+            nb::overload_cast<const SignatureBuilder*>(&NativeCallDataCache::find_call_data, nb::const_),
+            "builder"_a,
+            D_NA(NativeCallDataCache, find_call_data)
+        )
         .def(
             "add_call_data",
-            &NativeCallDataCache::add_call_data,
+            nb::overload_cast<const std::string&, const ref<NativeCallData>&>(&NativeCallDataCache::add_call_data),
             "signature"_a,
             "call_data"_a,
             D_NA(NativeCallDataCache, add_call_data)
         )
+        .def(
+            "add_call_data",
+            nb::overload_cast<const SignatureBuilder*, const ref<NativeCallData>&>(
+                &NativeCallDataCache::add_call_data
+            ),
+            "builder"_a,
+            "call_data"_a,
+            D_NA(NativeCallDataCache, add_call_data)
+        )
+        .def_prop_ro("size", &NativeCallDataCache::size, D_NA(NativeCallDataCache, size))
         .def(
             "lookup_value_signature",
             &NativeCallDataCache::lookup_value_signature,
@@ -1510,6 +1799,22 @@ SGL_PY_EXPORT(utils_slangpy)
         );
 
 
+    nb::class_<NativeCallBatch, Object>(slangpy, "NativeCallBatch") //
+        .def(nb::init<ref<Device>>(), "device"_a, D_NA(NativeCallBatch, NativeCallBatch))
+        .def_prop_ro("device", &NativeCallBatch::device, D_NA(NativeCallBatch, device))
+        .def("__len__", &NativeCallBatch::size, D_NA(NativeCallBatch, size))
+        .def(
+            "add_call",
+            &NativeCallBatch::add_call,
+            "call_data"_a,
+            "opts"_a,
+            "args"_a,
+            "kwargs"_a,
+            D_NA(NativeCallBatch, add_call)
+        )
+        .def("submit", &NativeCallBatch::submit, "cuda_stream"_a = NativeHandle(), D_NA(NativeCallBatch, submit))
+        .def("clear", &NativeCallBatch::clear, D_NA(NativeCallBatch, clear));
+
     nb::class_<Shape>(slangpy, "Shape") //
         .def(
             "__init__",
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <map>
 #include <typeindex>
@@ -12,6 +13,7 @@
 #include "sgl/core/macros.h"
 #include "sgl/core/fwd.h"
 #include "sgl/core/object.h"
+#include "sgl/core/short_vector.h"
 #include "sgl/device/fwd.h"
 #include "sgl/device/shader_cursor.h"
 #include "sgl/device/shader_object.h"
@@ -50,7 +52,36 @@ private:
     ref<NativeCallData> m_context;
 };
 
-/// Used during calculation of slangpy signature
+/// 128-bit hash of a slangpy signature.
+struct SignatureHash {
+    uint64_t lo{0xcbf29ce484222325ull};
+    uint64_t hi{0x84222325cbf29ce4ull};
+
+    bool operator==(const SignatureHash& other) const = default;
+
+    /// Append bytes to the hash. Hashing is done per byte, so the result only
+    /// depends on the byte sequence, not on how it was split into chunks.
+    void update(const uint8_t* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i) {
+            lo = (lo ^ data[i]) * 0x100000001b3ull;
+            hi = (hi ^ data[i]) * 0x9e3779b97f4a7c15ull;
+        }
+    }
+
+    /// Fold both lanes into a well mixed 64-bit value, used to index hash tables.
+    uint64_t fold() const
+    {
+        uint64_t h = lo ^ (hi >> 32 | hi << 32);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return h ^ (h >> 31);
+    }
+};
+
+/// Used during calculation of slangpy signature. Maintains a running hash
+/// of the signature as it is built, so the signature can be looked up without
+/// first converting it to a string.
 class SignatureBuilder : public Object {
     SGL_OBJECT(SignatureBuilder)
 public:
@@ -84,11 +115,21 @@ public:
 
     std::string dbg_as_string() const { return std::string((const char*)m_buffer, m_size); }
 
+    /// Raw signature bytes.
+    const uint8_t* data() const { return m_buffer; }
+
+    /// Size of signature in bytes.
+    size_t size() const { return m_size; }
+
+    /// Hash of all bytes added so far.
+    const SignatureHash& hash() const { return m_hash; }
+
 private:
     uint8_t m_initial_buffer[1024];
     uint8_t* m_buffer;
     size_t m_size;
     size_t m_capacity;
+    SignatureHash m_hash;
 
     void add_bytes(const uint8_t* data, size_t size)
     {
@@ -102,9 +143,37 @@ private:
         }
         memcpy(m_buffer + m_size, data, size);
         m_size += size;
+        m_hash.update(data, size);
     };
 };
 
+/// Flat plan of resolved shader field locations. The first time a field is looked up by
+/// name, its offset relative to the parent cursor and its type layout are recorded. Later
+/// lookups against a parent with the same type layout replay the recorded offsets and skip
+/// the reflection lookup done by ShaderCursor::find_field.
+class CursorWritePlan {
+public:
+    /// Get the field of a parent cursor by name, throwing if it does not exist.
+    /// Equivalent to parent[name].
+    ShaderCursor field(const ShaderCursor& parent, std::string_view name);
+
+    /// Number of recorded field locations.
+    size_t size() const { return m_entries.size(); }
+
+    /// Discard all recorded field locations.
+    void clear() { m_entries.clear(); }
+
+private:
+    struct Entry {
+        slang::TypeLayoutReflection* parent_type_layout;
+        std::string name;
+        slang::TypeLayoutReflection* type_layout;
+        uint32_t uniform_offset;
+        uint32_t binding_range_offset;
+    };
+    std::vector<Entry> m_entries;
+};
+
 /// Base class for types that can be passed to a slang function. Use of
 /// this is optional, but it is the fastest way to supply signatures
 /// to slangpy without entering python code. A user can set a fixed
@@ -504,6 +573,27 @@ public:
     /// Set the call dimensionality.
     void set_call_dimensionality(int call_dimensionality) { m_call_dimensionality = call_dimensionality; }
 
+    /// Get a field of the cursor by name, using the recorded write plan of this variable
+    /// to avoid reflection lookups on repeated dispatches.
+    ShaderCursor resolve_field(const ShaderCursor& cursor, std::string_view name)
+    {
+        return m_write_plan.field(cursor, name);
+    }
+
+    /// Discard the recorded write plans of this variable and its children.
+    /// Must be called when the pipeline the plans were recorded against changes.
+    void clear_write_plans()
+    {
+        m_write_plan.clear();
+        if (m_children) {
+            for (const auto& [name, child_ref] : *m_children) {
+                if (child_ref) {
+                    child_ref->clear_write_plans();
+                }
+            }
+        }
+    }
+
     /// Recursively populate the overall kernel call shape.
     void populate_call_shape(std::vector<int>& call_shape, nb::object value, NativeCallData* error_context);
 
@@ -531,6 +621,7 @@ private:
     int m_call_dimensionality{0};
     ref<NativeSlangType> m_vector_type;
     bool m_is_param_block{false};
+    CursorWritePlan m_write_plan;
 };
 
 /// Binding information for a call to a compute kernel. Includes a set of positional
@@ -562,6 +653,21 @@ public:
         return it->second;
     }
 
+    /// Discard the recorded write plans of all arguments.
+    void clear_write_plans()
+    {
+        for (const auto& arg : m_args) {
+            if (arg) {
+                arg->clear_write_plans();
+            }
+        }
+        for (const auto& [name, kwarg] : m_kwargs) {
+            if (kwarg) {
+                kwarg->clear_write_plans();
+            }
+        }
+    }
+
     /// Calculate the overall call shape by combining the shapes of all arguments.
     Shape calculate_call_shape(int call_dimensionality, nb::list args, nb::dict kwargs, NativeCallData* error_context);
 
@@ -627,6 +733,23 @@ private:
     bool m_is_ray_tracing{false};
 };
 
+/// State of a single kernel call, carried from argument preparation through dispatch
+/// to read back. Splitting a call into these phases allows several calls to share
+/// one command encoder and one submit. Not movable, as it holds short vectors.
+struct NativeCallDispatch {
+    ref<NativeCallRuntimeOptions> opts;
+    nb::args args;
+    nb::kwargs kwargs;
+    nb::list unpacked_args;
+    nb::dict unpacked_kwargs;
+    ref<CallContext> context;
+    Shape call_shape;
+    short_vector<int, 32> call_grid_shape;
+    short_vector<int, 32> call_grid_strides;
+    int total_threads{0};
+    nb::list read_back;
+};
+
 /// Defines the common logging functions for a given log level.
 /// The functions are:
 /// - name(msg)
@@ -659,7 +782,14 @@ public:
     ref<Pipeline> pipeline() const { return m_pipeline; }
 
     /// Set the pipeline.
-    void set_pipeline(const ref<Pipeline>& pipeline) { m_pipeline = pipeline; }
+    void set_pipeline(const ref<Pipeline>& pipeline)
+    {
+        m_pipeline = pipeline;
+        m_write_plan.clear();
+        if (m_runtime) {
+            m_runtime->clear_write_plans();
+        }
+    }
 
     /// Get the ray tracing shader table.
     ref<ShaderTable> shader_table() const { return m_shader_table; }
@@ -738,6 +868,16 @@ public:
     nb::object
     append_to(ref<NativeCallRuntimeOptions> opts, CommandEncoder* command_encoder, nb::args args, nb::kwargs kwargs);
 
+    /// Unpack arguments, calculate the call shape and dispatch dimensions, and allocate
+    /// the return value unless appending to a user provided command encoder.
+    void prepare_dispatch(NativeCallDispatch& dispatch, bool is_append);
+
+    /// Write call data and uniforms of a prepared dispatch to the root shader cursor.
+    void bind_call_data(NativeCallDispatch& dispatch, ShaderCursor cursor);
+
+    /// Read back call data and the return value once the dispatch has been submitted.
+    nb::object finish_dispatch(NativeCallDispatch& dispatch);
+
     /// Log a message, using either the provided logger or the default logger.
     void log(LogLevel level, const std::string_view msg, LogFrequency frequency = LogFrequency::always)
     {
@@ -790,6 +930,7 @@ private:
     Shape m_call_group_shape;
     bool m_torch_integration{false};
     bool m_torch_autograd{false};
+    CursorWritePlan m_write_plan;
 
     nb::object
     exec(ref<NativeCallRuntimeOptions> opts, CommandEncoder* command_encoder, nb::args args, nb::kwargs kwargs);
@@ -808,6 +949,46 @@ public:
     ) override;
 };
 
+/// Collects many kernel calls and encodes them into a single command encoder, which is
+/// submitted once. Calls can read the outputs of calls added before them. Call data and
+/// return values of all calls are read back after that single submit.
+class NativeCallBatch : Object {
+    SGL_OBJECT(NativeCallBatch)
+public:
+    NativeCallBatch(ref<Device> device);
+
+    /// Get the device.
+    ref<Device> device() const { return m_device; }
+
+    /// Get the number of pending calls.
+    size_t size() const { return m_calls.size(); }
+
+    /// Prepare a call and add it to the batch. Returns the index of its result in the
+    /// list returned by submit.
+    size_t add_call(
+        ref<NativeCallData> call_data,
+        ref<NativeCallRuntimeOptions> opts,
+        nb::args args,
+        nb::kwargs kwargs
+    );
+
+    /// Encode all pending calls into one command encoder, submit it and read back the results.
+    /// Returns the result of each call in the order they were added.
+    nb::list submit(NativeHandle cuda_stream = {});
+
+    /// Discard all pending calls without dispatching them.
+    void clear() { m_calls.clear(); }
+
+private:
+    struct Entry {
+        ref<NativeCallData> call_data;
+        NativeCallDispatch dispatch;
+    };
+
+    ref<Device> m_device;
+    std::vector<std::unique_ptr<Entry>> m_calls;
+};
+
 typedef std::function<bool(const ref<SignatureBuilder>& builder, nb::handle)> BuildSignatureFunc;
 
 /// Native side of system for caching call data info for given function signatures.
@@ -821,20 +1002,38 @@ public:
 
     void get_args_signature(const ref<SignatureBuilder> builder, nb::args args, nb::kwargs kwargs);
 
-    ref<NativeCallData> find_call_data(const std::string& signature)
+    /// Find call data for the signature held by a builder. Uses the builder's running hash,
+    /// so no signature string is constructed.
+    ref<NativeCallData> find_call_data(const SignatureBuilder* builder) const
     {
-        auto it = m_cache.find(signature);
-        if (it != m_cache.end()) {
-            return it->second;
-        }
-        return nullptr;
+        return find_call_data(builder->hash(), builder->data(), builder->size());
+    }
+
+    /// Add call data for the signature held by a builder.
+    void add_call_data(const SignatureBuilder* builder, const ref<NativeCallData>& call_data)
+    {
+        add_call_data(builder->hash(), builder->data(), builder->size(), call_data);
+    }
+
+    ref<NativeCallData> find_call_data(const std::string& signature) const
+    {
+        auto data = reinterpret_cast<const uint8_t*>(signature.data());
+        SignatureHash hash;
+        hash.update(data, signature.size());
+        return find_call_data(hash, data, signature.size());
     }
 
     void add_call_data(const std::string& signature, const ref<NativeCallData>& call_data)
     {
-        m_cache[signature] = call_data;
+        auto data = reinterpret_cast<const uint8_t*>(signature.data());
+        SignatureHash hash;
+        hash.update(data, signature.size());
+        add_call_data(hash, data, signature.size(), call_data);
     }
 
+    /// Number of cached call data entries.
+    size_t size() const { return m_count; }
+
     virtual std::optional<std::string> lookup_value_signature(nb::handle o)
     {
         SGL_UNUSED(o);
@@ -842,8 +1041,74 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, ref<NativeCallData>> m_cache;
+    /// Slot in the open addressing table. The full signature is kept to verify
+    /// hash hits, so a hash collision can never return the wrong call data.
+    struct Slot {
+        bool used{false};
+        SignatureHash hash;
+        std::string signature;
+        ref<NativeCallData> call_data;
+    };
+
+    /// How values of a Python type are written to a signature.
+    enum class ValueKind : uint8_t {
+        native_object,
+        int_,
+        float_,
+        bool_,
+        string,
+        tuple,
+        list,
+        object,
+    };
+
+    /// Result of classifying a Python type, so later values of the same type skip
+    /// straight to the right encoder instead of probing isinstance and attributes.
+    struct ValueTypeInfo {
+        /// Strong reference to the type, so a new type can't reuse its address while cached.
+        nb::object type;
+        ValueKind kind{ValueKind::object};
+        /// Signature function from the type signature table, tried before kind.
+        const BuildSignatureFunc* table_func{nullptr};
+        /// Native type name for native objects, Python __name__ for generic objects.
+        std::string type_name;
+        /// Version tag of the type when classified. Only checked for generic objects,
+        /// whose classification depends on class attributes that can be modified.
+        unsigned int version_tag{0};
+        /// Type overrides attribute lookup, so attributes must always be queried.
+        bool dynamic_attrs{false};
+        /// Instances have a __dict__ that may hold get_this/slangpy_signature.
+        bool instance_dict{false};
+        bool type_get_this{false};
+        bool type_slangpy_signature{false};
+        /// Type could be imported as a CUDA ndarray (tensor).
+        bool maybe_tensor{false};
+        bool is_dict{false};
+    };
+
+    /// Power of two sized table, probed linearly and kept at most half full.
+    std::vector<Slot> m_slots;
+    size_t m_count{0};
     std::unordered_map<std::type_index, BuildSignatureFunc> m_type_signature_table;
+    std::unordered_map<PyTypeObject*, ValueTypeInfo> m_value_types;
+
+    /// Maximum number of classified types, types created at runtime would otherwise grow the map forever.
+    static constexpr size_t MAX_VALUE_TYPES = 1024;
+
+    /// Clear classified types if there are too many. Only called from the top level signature functions,
+    /// as recursive calls hold references into the map.
+    void trim_value_types();
+    const ValueTypeInfo& classify_value_type(nb::handle o);
+    void append_value_signature(const ref<SignatureBuilder> builder, nb::handle o);
+
+    size_t find_slot(const SignatureHash& hash, const uint8_t* data, size_t size) const;
+    ref<NativeCallData> find_call_data(const SignatureHash& hash, const uint8_t* data, size_t size) const;
+    void add_call_data(
+        const SignatureHash& hash,
+        const uint8_t* data,
+        size_t size,
+        const ref<NativeCallData>& call_data
+    );
 };
 
 class PyNativeCallDataCache : public NativeCallDataCache {
@@ -85,21 +85,21 @@ void NativeNDBufferMarshall::write_shader_cursor_pre_dispatch(
 
     // Cast value to buffer, and get the cursor field to write to.
     auto buffer = nb::cast<NativeNDBuffer*>(value);
-    ShaderCursor field = cursor[binding->variable_name()];
+    ShaderCursor field = binding->resolve_field(cursor, binding->variable_name());
 
     // Write the buffer storage.
-    field["buffer"] = buffer->storage();
+    binding->resolve_field(field, "buffer") = buffer->storage();
 
     // Write shape vector as an array of ints.
     const std::vector<int>& shape_vec = buffer->shape().as_vector();
-    field["_shape"]
+    binding->resolve_field(field, "_shape")
         ._set_array_unsafe(&shape_vec[0], shape_vec.size() * 4, shape_vec.size(), TypeReflection::ScalarType::int32);
 
     // Write layout info to layout field.
-    auto layout_field = field["layout"];
+    auto layout_field = binding->resolve_field(field, "layout");
 
     // Write the offset into the buffer
-    layout_field["offset"] = buffer->offset();
+    binding->resolve_field(layout_field, "offset") = buffer->offset();
 
     // Generate and write strides vector, clearing strides to 0
     // for dimensions that are broadcast.
@@ -114,7 +114,7 @@ void NativeNDBufferMarshall::write_shader_cursor_pre_dispatch(
     }
 
     // Write the strides vector as an array of ints.
-    layout_field["strides"]._set_array_unsafe(
+    binding->resolve_field(layout_field, "strides")._set_array_unsafe(
         &strides_vec[0],
         strides_vec.size() * 4,
         strides_vec.size(),
@@ -138,11 +138,11 @@ void NativeNDBufferMarshall::read_calldata(
 nb::object NativeNDBufferMarshall::create_output(CallContext* context, NativeBoundVariableRuntime* binding) const
 {
     SGL_UNUSED(binding);
-    auto buffer = create_buffer(context->device(), context->call_shape());
+    auto buffer = create_buffer(context->device(), context->call_shape(), true);
     return nb::cast(buffer);
 }
 
-ref<NativeNDBuffer> NativeNDBufferMarshall::create_buffer(Device* device, const Shape& shape) const
+ref<NativeNDBuffer> NativeNDBufferMarshall::create_buffer(Device* device, const Shape& shape, bool pooled) const
 {
     NativeNDBufferDesc desc;
     desc.dtype = m_slang_element_type;
@@ -152,7 +152,18 @@ ref<NativeNDBuffer> NativeNDBufferMarshall::create_buffer(Device* device, const
     desc.strides = desc.shape.calc_contiguous_strides();
     desc.usage = BufferUsage::shader_resource | BufferUsage::unordered_access;
     desc.memory_type = MemoryType::device_local;
-    return make_ref<NativeNDBuffer>(device, desc);
+
+    // Pooled storage may be larger than the shape requires.
+    ref<Buffer> storage;
+    if (pooled) {
+        BufferDesc buffer_desc;
+        buffer_desc.element_count = desc.shape.element_count();
+        buffer_desc.struct_size = desc.element_layout->stride();
+        buffer_desc.usage = desc.usage;
+        buffer_desc.memory_type = desc.memory_type;
+        storage = device->buffer_pool()->allocate(buffer_desc);
+    }
+    return make_ref<NativeNDBuffer>(device, desc, std::move(storage));
 }
 
 nb::object NativeNDBufferMarshall::create_dispatchdata(nb::object data) const
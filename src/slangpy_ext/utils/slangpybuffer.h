@@ -89,7 +89,9 @@ public:
     nb::object read_output(CallContext* context, NativeBoundVariableRuntime* binding, nb::object data) const override;
 
 protected:
-    ref<NativeNDBuffer> create_buffer(Device* device, const Shape& shape) const;
+    /// Create an NDBuffer of the given shape. If pooled, storage is taken from the device's
+    /// buffer pool and may be larger than the shape requires.
+    ref<NativeNDBuffer> create_buffer(Device* device, const Shape& shape, bool pooled = false) const;
 
 private:
     int m_dims;
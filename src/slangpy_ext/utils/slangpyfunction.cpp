@@ -36,11 +36,10 @@ ref<NativeCallData> NativeFunctionNode::build_call_data(NativeCallDataCache* cac
     read_signature(builder);
     cache->get_args_signature(builder, args, kwargs);
 
-    std::string sig = builder->str();
-    ref<NativeCallData> result = cache->find_call_data(sig);
+    ref<NativeCallData> result = cache->find_call_data(builder);
     if (!result) {
         result = generate_call_data(args, kwargs);
-        cache->add_call_data(sig, result);
+        cache->add_call_data(builder, result);
     }
     return result;
 }
@@ -59,8 +58,7 @@ nb::object NativeFunctionNode::call(NativeCallDataCache* cache, nb::args args, n
     read_signature(builder);
     cache->get_args_signature(builder, args, kwargs);
 
-    std::string sig = builder->str();
-    ref<NativeCallData> call_data = cache->find_call_data(sig);
+    ref<NativeCallData> call_data = cache->find_call_data(builder);
 
     if (call_data) {
         if (call_data->is_torch_integration())
@@ -69,7 +67,7 @@ nb::object NativeFunctionNode::call(NativeCallDataCache* cache, nb::args args, n
             return call_data->call(options, args, kwargs);
     } else {
         ref<NativeCallData> new_call_data = generate_call_data(args, kwargs);
-        cache->add_call_data(sig, new_call_data);
+        cache->add_call_data(builder, new_call_data);
         if (new_call_data->is_torch_integration())
             return new_call_data->_py_torch_call(this, options, args, kwargs);
         else
@@ -96,19 +94,41 @@ void NativeFunctionNode::append_to(
     read_signature(builder);
     cache->get_args_signature(builder, args, kwargs);
 
-
-    std::string sig = builder->str();
-    NativeCallData* call_data = cache->find_call_data(sig);
+    ref<NativeCallData> call_data = cache->find_call_data(builder);
 
     if (call_data) {
         call_data->append_to(options, command_encoder, args, kwargs);
     } else {
         ref<NativeCallData> new_call_data = generate_call_data(args, kwargs);
-        cache->add_call_data(sig, new_call_data);
+        cache->add_call_data(builder, new_call_data);
         new_call_data->append_to(options, command_encoder, args, kwargs);
     }
 }
 
+size_t
+NativeFunctionNode::append_to_batch(NativeCallDataCache* cache, NativeCallBatch* batch, nb::args args, nb::kwargs kwargs)
+{
+    auto options = make_ref<NativeCallRuntimeOptions>();
+    gather_runtime_options(options);
+
+    if (!options->get_this().is_none()) {
+        args = nb::cast<nb::args>(nb::make_tuple(options->get_this()) + args);
+    }
+
+    auto builder = make_ref<SignatureBuilder>();
+    read_signature(builder);
+    cache->get_args_signature(builder, args, kwargs);
+
+    ref<NativeCallData> call_data = cache->find_call_data(builder);
+    if (!call_data) {
+        call_data = generate_call_data(args, kwargs);
+        cache->add_call_data(builder, call_data);
+    }
+
+    SGL_CHECK(!call_data->is_torch_integration(), "Calls with torch integration cannot be added to a call batch.");
+    return batch->add_call(call_data, options, args, kwargs);
+}
+
 std::string NativeFunctionNode::to_string() const
 {
     std::string data_type_name = "None";
@@ -176,6 +196,15 @@ SGL_PY_EXPORT(utils_slangpy_function)
             "kwargs"_a,
             D_NA(NativeFunctionNode, append_to)
         )
+        .def(
+            "_native_append_to_batch",
+            &NativeFunctionNode::append_to_batch,
+            "cache"_a,
+            "batch"_a,
+            "args"_a,
+            "kwargs"_a,
+            D_NA(NativeFunctionNode, append_to_batch)
+        )
         .def(
             "generate_call_data",
             &NativeFunctionNode::generate_call_data,
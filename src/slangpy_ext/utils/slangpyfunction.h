@@ -112,6 +112,8 @@ public:
 
     void append_to(NativeCallDataCache* cache, CommandEncoder* command_encoder, nb::args args, nb::kwargs kwargs);
 
+    size_t append_to_batch(NativeCallDataCache* cache, NativeCallBatch* batch, nb::args args, nb::kwargs kwargs);
+
     /// Get string representation of the function node.
     std::string to_string() const override;
 
@@ -39,7 +39,7 @@ void NativeBufferMarshall::write_shader_cursor_pre_dispatch(
     if (primal_access != AccessType::none) {
         SGL_UNUSED(binding);
         SGL_UNUSED(context);
-        ShaderCursor field = cursor[binding->variable_name()]["value"];
+        ShaderCursor field = binding->resolve_field(binding->resolve_field(cursor, binding->variable_name()), "value");
         ref<BufferView> view;
         if (nb::try_cast(value, view)) {
             field.set_buffer_view(view);
@@ -70,7 +70,7 @@ void NativeDescriptorMarshall::write_shader_cursor_pre_dispatch(
     if (primal_access != AccessType::none) {
         SGL_UNUSED(binding);
         SGL_UNUSED(context);
-        ShaderCursor field = cursor[binding->variable_name()]["value"];
+        ShaderCursor field = binding->resolve_field(binding->resolve_field(cursor, binding->variable_name()), "value");
         auto handle = nb::cast<DescriptorHandle>(value);
         field.set_descriptor_handle(handle);
     }
@@ -89,7 +89,7 @@ void NativeTextureMarshall::write_shader_cursor_pre_dispatch(
     AccessType primal_access = binding->access().first;
     if (primal_access != AccessType::none) {
 
-        ShaderCursor field = cursor[binding->variable_name()]["value"];
+        ShaderCursor field = binding->resolve_field(binding->resolve_field(cursor, binding->variable_name()), "value");
         ref<TextureView> view;
         if (nb::try_cast(value, view)) {
             field.set_texture_view(view);
@@ -377,8 +377,22 @@ nb::ndarray<nb::numpy> StridedBufferView::to_numpy() const
     size_t dtype_size = desc().element_layout->stride();
     size_t byte_offset = desc().offset * dtype_size;
     size_t data_size = m_storage->size() - byte_offset;
+
+    // Only copy the elements covered by the view, storage can be larger (e.g. when taken from the buffer pool).
+    const Shape& shape = desc().shape;
+    const Shape& strides = desc().strides;
+    size_t element_extent = shape.element_count() > 0 ? 1 : 0;
+    bool has_negative_stride = false;
+    for (size_t i = 0; i < shape.size() && element_extent > 0; ++i) {
+        has_negative_stride |= strides[i] < 0;
+        element_extent += size_t(shape[i] - 1) * size_t(std::max(strides[i], 0));
+    }
+    if (!has_negative_stride)
+        data_size = std::min(data_size, element_extent * dtype_size);
+
     void* data = new uint8_t[data_size];
-    m_storage->get_data(data, data_size, byte_offset);
+    if (data_size > 0)
+        m_storage->get_data(data, data_size, byte_offset);
     nb::capsule owner(
         data,
         [](void* p) noexcept
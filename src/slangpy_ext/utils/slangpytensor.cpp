@@ -208,10 +208,10 @@ void NativeTensorMarshall::write_pytorch_tensor_fields(
                           int offset)
     {
         // Write buffer pointer
-        cursor["buffer"].set_pointer(reinterpret_cast<uint64_t>(data_ptr));
+        binding->resolve_field(cursor, "buffer").set_pointer(reinterpret_cast<uint64_t>(data_ptr));
 
         // Write shape
-        cursor["_shape"]._set_array_unsafe(
+        binding->resolve_field(cursor, "_shape")._set_array_unsafe(
             shape.empty() ? nullptr : &shape[0],
             shape.size() * 4,
             shape.size(),
@@ -230,14 +230,14 @@ void NativeTensorMarshall::write_pytorch_tensor_fields(
         }
 
         // Write layout
-        auto layout = cursor["layout"];
-        layout["strides"]._set_array_unsafe(
+        auto layout = binding->resolve_field(cursor, "layout");
+        binding->resolve_field(layout, "strides")._set_array_unsafe(
             strides.empty() ? nullptr : &strides[0],
             strides.size() * 4,
             strides.size(),
             TypeReflection::ScalarType::int32
         );
-        layout["offset"] = offset;
+        binding->resolve_field(layout, "offset") = offset;
     };
 
     // Write primal tensor
@@ -251,7 +251,7 @@ void NativeTensorMarshall::write_pytorch_tensor_fields(
         );
     } else {
         write_data(
-            field["primal"],
+            binding->resolve_field(field, "primal"),
             pytorch_tensor.data(),
             extract_shape(pytorch_tensor),
             extract_strides(pytorch_tensor),
@@ -266,7 +266,7 @@ void NativeTensorMarshall::write_pytorch_tensor_fields(
             if (grad_in_tensor_opt.has_value()) {
                 auto& grad_in_tensor = grad_in_tensor_opt.value();
                 write_data(
-                    field["d_in"],
+                    binding->resolve_field(field, "d_in"),
                     grad_in_tensor.data(),
                     extract_shape(grad_in_tensor),
                     extract_strides(grad_in_tensor),
@@ -283,7 +283,7 @@ void NativeTensorMarshall::write_pytorch_tensor_fields(
             if (grad_out_tensor_opt.has_value()) {
                 auto& grad_out_tensor = grad_out_tensor_opt.value();
                 write_data(
-                    field["d_out"],
+                    binding->resolve_field(field, "d_out"),
                     grad_out_tensor.data(),
                     extract_shape(grad_out_tensor),
                     extract_strides(grad_out_tensor),
@@ -307,7 +307,7 @@ void NativeTensorMarshall::write_shader_cursor_pre_dispatch(
     // base class implementation.
     NativeTensor* primal;
     if (nb::try_cast(value, primal)) {
-        ShaderCursor field = cursor[binding->variable_name()];
+        ShaderCursor field = binding->resolve_field(cursor, binding->variable_name());
 
         const ref<NativeTensor>& grad_in = primal->grad_in();
         const ref<NativeTensor>& grad_out = primal->grad_out();
@@ -315,14 +315,26 @@ void NativeTensorMarshall::write_shader_cursor_pre_dispatch(
         if (!has_derivative()) {
             write_shader_cursor_fields(context, binding, field, primal, read_back);
         } else {
-            write_shader_cursor_fields(context, binding, field["primal"], primal, read_back);
+            write_shader_cursor_fields(context, binding, binding->resolve_field(field, "primal"), primal, read_back);
             if (m_d_in) {
                 SGL_CHECK(grad_in, "Missing required input gradients");
-                write_shader_cursor_fields(context, binding, field["d_in"], grad_in.get(), read_back);
+                write_shader_cursor_fields(
+                    context,
+                    binding,
+                    binding->resolve_field(field, "d_in"),
+                    grad_in.get(),
+                    read_back
+                );
             }
             if (m_d_out) {
                 SGL_CHECK(grad_out, "Missing required input gradients");
-                write_shader_cursor_fields(context, binding, field["d_out"], grad_out.get(), read_back);
+                write_shader_cursor_fields(
+                    context,
+                    binding,
+                    binding->resolve_field(field, "d_out"),
+                    grad_out.get(),
+                    read_back
+                );
             }
         }
 
@@ -341,7 +353,7 @@ void NativeTensorMarshall::write_shader_cursor_pre_dispatch(
         auto pytorch_tensor_opt = tensorref->tensor();
         // Only use fast path for CUDA tensors - other backends need interop buffer
         if (pytorch_tensor_opt.has_value() && context->device()->type() == DeviceType::cuda) {
-            ShaderCursor field = cursor[binding->variable_name()];
+            ShaderCursor field = binding->resolve_field(cursor, binding->variable_name());
             write_pytorch_tensor_fields(context, binding, field, tensorref, read_back);
             return;
         }
@@ -362,11 +374,11 @@ void NativeTensorMarshall::write_shader_cursor_fields(
     SGL_UNUSED(read_back);
 
     // Write the buffer storage.
-    field["buffer"] = buffer->storage();
+    binding->resolve_field(field, "buffer") = buffer->storage();
 
     // Write shape vector as an array of ints.
     const std::vector<int>& shape_vec = buffer->shape().as_vector();
-    field["_shape"]
+    binding->resolve_field(field, "_shape")
         ._set_array_unsafe(&shape_vec[0], shape_vec.size() * 4, shape_vec.size(), TypeReflection::ScalarType::int32);
 
     // Generate and write strides vector, clearing strides to 0
@@ -382,14 +394,14 @@ void NativeTensorMarshall::write_shader_cursor_fields(
     }
 
     // Write the strides vector as an array of ints.
-    auto layout_field = field["layout"];
-    layout_field["strides"]._set_array_unsafe(
+    auto layout_field = binding->resolve_field(field, "layout");
+    binding->resolve_field(layout_field, "strides")._set_array_unsafe(
         &strides_vec[0],
         strides_vec.size() * 4,
         strides_vec.size(),
         TypeReflection::ScalarType::int32
     );
-    layout_field["offset"] = buffer->offset();
+    binding->resolve_field(layout_field, "offset") = buffer->offset();
 }
 
 void NativeTensorMarshall::read_calldata(
@@ -414,12 +426,12 @@ nb::object NativeTensorMarshall::create_output(CallContext* context, NativeBound
     ref<TypeLayoutReflection> layout = m_element_layout;
     auto& shape = context->call_shape();
 
-    // Create a new structured buffer for storage.
+    // Allocate a structured buffer for storage from the device's buffer pool.
     BufferDesc buffer_desc;
     buffer_desc.usage = BufferUsage::shader_resource | BufferUsage::unordered_access | BufferUsage::shared;
     buffer_desc.struct_size = layout->stride();
     buffer_desc.element_count = shape.element_count();
-    ref<Buffer> buffer = context->device()->create_buffer(buffer_desc);
+    ref<Buffer> buffer = context->device()->buffer_pool()->allocate(buffer_desc);
 
     NativeTensorDesc desc;
     desc.dtype = dtype;
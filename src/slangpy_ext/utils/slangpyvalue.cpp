@@ -22,7 +22,7 @@ void NativeValueMarshall::write_shader_cursor_pre_dispatch(
     SGL_UNUSED(read_back);
     AccessType primal_access = binding->access().first;
     if (!value.is_none() && (primal_access == AccessType::read || primal_access == AccessType::readwrite)) {
-        ShaderCursor field = cursor[binding->variable_name()]["value"];
+        ShaderCursor field = binding->resolve_field(binding->resolve_field(cursor, binding->variable_name()), "value");
         write_shader_cursor(field, value);
     }
 }
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "testing.h"
+#include "sgl/core/bitmap.h"
+#include "sgl/core/timer.h"
+#include "sgl/core/type_utils.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define PRINT_DIAGNOSTICS 0
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("bitmap");
+
+using PixelFormat = Bitmap::PixelFormat;
+using ComponentType = Bitmap::ComponentType;
+
+static uint32_t rng()
+{
+    static constexpr uint32_t A = 1664525u;
+    static constexpr uint32_t C = 1013904223u;
+    static uint32_t state = 0xdeadbeef;
+    state = (A * state + C);
+    return state;
+}
+
+/// Create a bitmap filled with random data.
+static ref<Bitmap> random_bitmap(
+    PixelFormat pixel_format,
+    ComponentType component_type,
+    uint32_t width,
+    uint32_t height,
+    const std::vector<std::string>& channel_names = {}
+)
+{
+    ref<Bitmap> bitmap = make_ref<Bitmap>(
+        pixel_format,
+        component_type,
+        width,
+        height,
+        narrow_cast<uint32_t>(channel_names.size()),
+        channel_names
+    );
+    uint32_t* data = static_cast<uint32_t*>(bitmap->data());
+    for (size_t i = 0; i < bitmap->buffer_size() / sizeof(uint32_t); ++i)
+        data[i] = rng() & 0x3f7fffff; // Keep float values finite.
+    return bitmap;
+}
+
+/// Channels of a multi-layer AOV image (in the order EXR files are read back in).
+static const std::vector<std::string> AOV_CHANNELS = {
+    "R",
+    "G",
+    "B",
+    "A",
+    "albedo.R",
+    "albedo.G",
+    "albedo.B",
+    "depth.Y",
+    "normal.R",
+    "normal.G",
+    "normal.B",
+};
+
+TEST_CASE("vflip")
+{
+    // Odd height to check the middle row is left untouched.
+    ref<Bitmap> bitmap = random_bitmap(PixelFormat::rgba, ComponentType::float32, 1031, 517);
+    ref<Bitmap> serial = bitmap->convert(PixelFormat::rgba, ComponentType::float32, false);
+    ref<Bitmap> parallel = bitmap->convert(PixelFormat::rgba, ComponentType::float32, false);
+
+    serial->vflip(false);
+    parallel->vflip(true);
+    CHECK(*serial == *parallel);
+
+    size_t row_size = bitmap->width() * bitmap->bytes_per_pixel();
+    for (uint32_t y = 0; y < bitmap->height(); ++y) {
+        const uint8_t* src = bitmap->uint8_data() + y * row_size;
+        const uint8_t* dst = parallel->uint8_data() + (bitmap->height() - 1 - y) * row_size;
+        CHECK(std::memcmp(src, dst, row_size) == 0);
+    }
+
+    parallel->vflip(true);
+    CHECK(*parallel == *bitmap);
+}
+
+TEST_CASE("split")
+{
+    ref<Bitmap> bitmap
+        = random_bitmap(PixelFormat::multi_channel, ComponentType::float32, 1024, 1024, AOV_CHANNELS);
+
+    auto serial = bitmap->split(false);
+    auto parallel = bitmap->split(true);
+    REQUIRE(serial.size() == parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        CHECK(serial[i].first == parallel[i].first);
+        CHECK(*serial[i].second == *parallel[i].second);
+    }
+}
+
+TEST_CASE("exr_threads")
+{
+    auto dir = testing::get_case_temp_directory();
+    ref<Bitmap> bitmap
+        = random_bitmap(PixelFormat::multi_channel, ComponentType::float16, 1920, 1080, AOV_CHANNELS);
+
+    uint32_t thread_count = Bitmap::exr_thread_count();
+    for (uint32_t count : {1u, 8u}) {
+        CAPTURE(count);
+        Bitmap::set_exr_thread_count(count);
+        std::filesystem::path path = dir / fmt::format("threads_{}.exr", count);
+        bitmap->write(path);
+        ref<Bitmap> loaded = make_ref<Bitmap>(path);
+        CHECK(*loaded == *bitmap);
+    }
+
+    std::vector<std::filesystem::path> paths(4, dir / "threads_8.exr");
+    for (const ref<Bitmap>& loaded : Bitmap::read_multiple(paths))
+        CHECK(*loaded == *bitmap);
+
+    Bitmap::set_exr_thread_count(thread_count);
+}
+
+/// Allocates over 1 GB of bitmap data (8K with 11 channels), only run when printing diagnostics.
+TEST_CASE("benchmark" * doctest::skip(!PRINT_DIAGNOSTICS))
+{
+    struct Resolution {
+        const char* name;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    Resolution resolutions[] = {
+        {"4K", 3840, 2160},
+        {"8K", 7680, 4320},
+    };
+
+    for (const Resolution& resolution : resolutions) {
+        ref<Bitmap> bitmap = random_bitmap(
+            PixelFormat::multi_channel,
+            ComponentType::float16,
+            resolution.width,
+            resolution.height,
+            AOV_CHANNELS
+        );
+
+        for (bool parallel : {false, true}) {
+            Timer timer;
+            bitmap->vflip(parallel);
+            double vflip_time = timer.elapsed_ms();
+
+            timer.reset();
+            auto layers = bitmap->split(parallel);
+            double split_time = timer.elapsed_ms();
+
+            timer.reset();
+            ref<Bitmap> converted = layers[0].second->convert(PixelFormat::rgba, ComponentType::uint8, true, parallel);
+            double convert_time = timer.elapsed_ms();
+
+#if PRINT_DIAGNOSTICS
+            fmt::println(
+                "{} ({}): vflip={:.1f}ms split={:.1f}ms convert={:.1f}ms",
+                resolution.name,
+                parallel ? "parallel" : "serial",
+                vflip_time,
+                split_time,
+                convert_time
+            );
+#else
+            (void)vflip_time;
+            (void)split_time;
+            (void)convert_time;
+#endif
+        }
+    }
+}
+
+TEST_SUITE_END();
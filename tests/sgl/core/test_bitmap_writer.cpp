@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "testing.h"
+#include "sgl/core/bitmap_writer.h"
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("bitmap_writer");
+
+using PixelFormat = Bitmap::PixelFormat;
+using ComponentType = Bitmap::ComponentType;
+
+/// Create a small bitmap with deterministic content.
+static ref<Bitmap> create_bitmap(uint32_t seed)
+{
+    ref<Bitmap> bitmap = make_ref<Bitmap>(PixelFormat::rgba, ComponentType::uint8, 64, 32);
+    uint8_t* data = bitmap->uint8_data();
+    for (size_t i = 0; i < bitmap->buffer_size(); ++i)
+        data[i] = uint8_t(i * 7 + seed);
+    return bitmap;
+}
+
+TEST_CASE("write")
+{
+    auto dir = testing::get_case_temp_directory();
+    ref<BitmapWriter> writer = make_ref<BitmapWriter>();
+
+    std::atomic<uint32_t> completed{0};
+    for (uint32_t i = 0; i < 16; ++i) {
+        bool queued = writer->write(
+            create_bitmap(i),
+            dir / fmt::format("{}.png", i),
+            Bitmap::FileFormat::auto_,
+            -1,
+            [&](const BitmapWriter::WriteResult& result)
+            {
+                CHECK(result.success);
+                completed++;
+            }
+        );
+        CHECK(queued);
+    }
+    writer->flush();
+
+    CHECK(completed == 16);
+    CHECK(writer->pending_count() == 0);
+    CHECK(writer->pending_bytes() == 0);
+    for (uint32_t i = 0; i < 16; ++i) {
+        ref<Bitmap> bitmap = make_ref<Bitmap>(dir / fmt::format("{}.png", i));
+        CHECK(*bitmap == *create_bitmap(i));
+    }
+}
+
+TEST_CASE("block")
+{
+    auto dir = testing::get_case_temp_directory();
+    size_t size = create_bitmap(0)->buffer_size();
+    // Only a single write can be pending at any time.
+    ref<BitmapWriter> writer = make_ref<BitmapWriter>(BitmapWriter::Options{
+        .max_pending_bytes = size,
+        .overflow_policy = BitmapWriter::OverflowPolicy::block,
+    });
+
+    std::atomic<size_t> max_pending_bytes{0};
+    for (uint32_t i = 0; i < 16; ++i) {
+        bool queued = writer->write(
+            create_bitmap(i),
+            dir / fmt::format("{}.png", i),
+            Bitmap::FileFormat::auto_,
+            -1,
+            [&](const BitmapWriter::WriteResult&)
+            {
+                size_t pending_bytes = writer->pending_bytes();
+                if (pending_bytes > max_pending_bytes)
+                    max_pending_bytes = pending_bytes;
+            }
+        );
+        CHECK(queued);
+    }
+    writer->flush();
+
+    CHECK(max_pending_bytes == size);
+    CHECK(writer->dropped_count() == 0);
+    for (uint32_t i = 0; i < 16; ++i)
+        CHECK(std::filesystem::exists(dir / fmt::format("{}.png", i)));
+}
+
+TEST_CASE("drop")
+{
+    auto dir = testing::get_case_temp_directory();
+    ref<BitmapWriter> writer = make_ref<BitmapWriter>(BitmapWriter::Options{
+        .max_pending_bytes = 1,
+        .overflow_policy = BitmapWriter::OverflowPolicy::drop,
+    });
+
+    uint32_t queued_count = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        if (writer->write(create_bitmap(i), dir / fmt::format("{}.png", i)))
+            queued_count++;
+        else
+            CHECK(!std::filesystem::exists(dir / fmt::format("{}.png", i)));
+    }
+    writer->flush();
+
+    CHECK(queued_count >= 1);
+    CHECK(queued_count + writer->dropped_count() == 16);
+}
+
+TEST_CASE("errors")
+{
+    auto dir = testing::get_case_temp_directory();
+    ref<BitmapWriter> writer = make_ref<BitmapWriter>();
+
+    std::string error;
+    writer->write(
+        create_bitmap(0),
+        dir / "missing" / "0.png",
+        Bitmap::FileFormat::auto_,
+        -1,
+        [&](const BitmapWriter::WriteResult& result)
+        {
+            CHECK(!result.success);
+            error = result.error;
+        }
+    );
+    writer->write(create_bitmap(1), dir / "1.png");
+    CHECK_THROWS(writer->flush());
+    CHECK(!error.empty());
+    CHECK(writer->failed_count() == 1);
+    CHECK(std::filesystem::exists(dir / "1.png"));
+
+    // Errors are only reported once.
+    writer->flush();
+}
+
+TEST_SUITE_END();
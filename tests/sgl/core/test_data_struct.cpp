@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "testing.h"
+#include "sgl/core/data_struct.h"
+#include "sgl/core/timer.h"
+#include "sgl/math/float16.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define PRINT_DIAGNOSTICS 0
+
+using namespace sgl;
+
+TEST_SUITE_BEGIN("data_struct");
+
+using Type = DataStruct::Type;
+using Flags = DataStruct::Flags;
+using Backend = DataStructConverter::Backend;
+
+static uint32_t rng()
+{
+    static constexpr uint32_t A = 1664525u;
+    static constexpr uint32_t C = 1013904223u;
+    static uint32_t state = 0xdeadbeef;
+    state = (A * state + C);
+    return state;
+}
+
+static ref<DataStruct> make_rgba(Type type, Flags flags = Flags::none)
+{
+    ref<DataStruct> s = make_ref<DataStruct>();
+    for (const char* name : {"r", "g", "b", "a"})
+        s->append(name, type, flags);
+    return s;
+}
+
+/// Generate random source data with valid values for all fields of the struct.
+static std::vector<uint8_t> random_data(const DataStruct* s, size_t count)
+{
+    std::vector<uint8_t> data(s->size() * count);
+    for (size_t i = 0; i < count; ++i) {
+        for (const auto& field : *s) {
+            uint8_t* ptr = data.data() + i * s->size() + field.offset;
+            uint32_t bits = rng();
+            if (field.type == Type::float16) {
+                // Values in [0, 2] with a few out of range values.
+                uint16_t value = math::float32_to_float16(float(bits % 2048) / 1024.f);
+                std::memcpy(ptr, &value, sizeof(value));
+            } else if (field.type == Type::float32) {
+                float value = float(bits % 1000000) / 800000.f - 0.1f;
+                std::memcpy(ptr, &value, sizeof(value));
+            } else {
+                std::memcpy(ptr, &bits, field.size);
+            }
+        }
+    }
+    return data;
+}
+
+/// Convert data with the given backend.
+static std::vector<uint8_t>
+convert(const DataStruct* src, const DataStruct* dst, Backend backend, const std::vector<uint8_t>& data)
+{
+    size_t count = data.size() / src->size();
+    std::vector<uint8_t> result(dst->size() * count);
+    ref<DataStructConverter> converter = make_ref<DataStructConverter>(src, dst, backend);
+    converter->convert(data.data(), result.data(), count);
+    return result;
+}
+
+/// Check that all backends produce the same results as the virtual machine.
+/// Floating point values are compared with a relative tolerance, integers need to match exactly.
+static void check_backends(const DataStruct* src, const DataStruct* dst, size_t count = 1000)
+{
+    std::vector<uint8_t> data = random_data(src, count);
+    std::vector<uint8_t> ref = convert(src, dst, Backend::vm, data);
+
+    for (Backend backend : {Backend::jit, Backend::block, Backend::automatic}) {
+        CAPTURE(int(backend));
+        std::vector<uint8_t> result = convert(src, dst, backend, data);
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& field : *dst) {
+                size_t offset = i * dst->size() + field.offset;
+                CAPTURE(i);
+                CAPTURE(field.name);
+                if (field.type == Type::float32) {
+                    float a, b;
+                    std::memcpy(&a, ref.data() + offset, sizeof(float));
+                    std::memcpy(&b, result.data() + offset, sizeof(float));
+                    CHECK(b == doctest::Approx(a).epsilon(1e-6));
+                } else if (field.type == Type::float16) {
+                    uint16_t a, b;
+                    std::memcpy(&a, ref.data() + offset, sizeof(uint16_t));
+                    std::memcpy(&b, result.data() + offset, sizeof(uint16_t));
+                    CHECK(math::float16_to_float32(b) == doctest::Approx(math::float16_to_float32(a)).epsilon(1e-3));
+                } else {
+                    CHECK(std::memcmp(ref.data() + offset, result.data() + offset, field.size) == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("convert_backends")
+{
+    const Flags norm = Flags::normalized;
+    const Flags srgb = Flags::normalized | Flags::srgb_gamma;
+
+    SUBCASE("passthrough")
+    {
+        ref<DataStruct> src = make_rgba(Type::uint8, norm);
+        ref<DataStruct> dst = make_ref<DataStruct>();
+        dst->append("a", Type::uint8, norm).append("b", Type::uint8, norm).append("g", Type::uint8, norm);
+        check_backends(src, dst);
+    }
+
+    SUBCASE("normalize")
+    {
+        for (Type type : {Type::uint8, Type::uint16}) {
+            check_backends(make_rgba(type, norm), make_rgba(Type::float32));
+            check_backends(make_rgba(Type::float32), make_rgba(type, norm));
+            check_backends(make_rgba(type, norm), make_rgba(Type::float16));
+            check_backends(make_rgba(Type::float16), make_rgba(type, norm));
+        }
+        check_backends(make_rgba(Type::uint8, norm), make_rgba(Type::uint16, norm));
+        check_backends(make_rgba(Type::uint16, norm), make_rgba(Type::uint8, norm));
+    }
+
+    SUBCASE("gamma")
+    {
+        for (Type type : {Type::uint8, Type::uint16}) {
+            check_backends(make_rgba(type, srgb), make_rgba(Type::float32));
+            check_backends(make_rgba(Type::float32), make_rgba(type, srgb));
+            check_backends(make_rgba(type, srgb), make_rgba(Type::float16));
+            check_backends(make_rgba(Type::float16), make_rgba(type, srgb));
+            check_backends(make_rgba(type, srgb), make_rgba(type, norm));
+            check_backends(make_rgba(type, norm), make_rgba(type, srgb));
+        }
+    }
+
+    SUBCASE("float")
+    {
+        check_backends(make_rgba(Type::float16), make_rgba(Type::float32));
+        check_backends(make_rgba(Type::float32), make_rgba(Type::float16));
+        check_backends(make_rgba(Type::float32), make_rgba(Type::uint8));
+    }
+
+    SUBCASE("default")
+    {
+        ref<DataStruct> src = make_ref<DataStruct>();
+        src->append("r", Type::uint8, norm).append("g", Type::uint8, norm).append("b", Type::uint8, norm);
+        ref<DataStruct> dst = make_rgba(Type::float32);
+        dst->field("a").flags |= Flags::default_;
+        dst->field("a").default_value = 0.5;
+        check_backends(src, dst);
+    }
+
+    SUBCASE("blend")
+    {
+        for (Type type : {Type::uint8, Type::float32}) {
+            ref<DataStruct> src = make_rgba(type, srgb);
+            ref<DataStruct> dst = make_ref<DataStruct>();
+            dst->append("y", Type::uint8, srgb, 0.0, {{0.2126, "r"}, {0.7152, "g"}, {0.0722, "b"}});
+            check_backends(src, dst);
+        }
+    }
+
+    SUBCASE("unsupported")
+    {
+        // Fall back to other backends for types not supported by the vectorized backend.
+        check_backends(make_rgba(Type::int16, norm), make_rgba(Type::float64));
+        ref<DataStruct> big_endian = make_ref<DataStruct>(true, DataStruct::ByteOrder::big_endian);
+        big_endian->append("r", Type::uint16, norm).append("a", Type::uint8, norm);
+        check_backends(make_rgba(Type::float32), big_endian);
+    }
+}
+
+TEST_CASE("program_cache_concurrent")
+{
+    // Compile new programs on some threads while others look up existing ones.
+    const Flags norm = Flags::normalized;
+    ref<DataStruct> src = make_ref<DataStruct>();
+    src->append("r", Type::uint8, norm).append("g", Type::uint8, norm).append("b", Type::uint8, norm);
+    const uint8_t rgb[3] = {0, 0, 0};
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(8, 0);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < 64; ++i) {
+                    // Threads with an even index share their programs, the others compile new ones.
+                    ref<DataStruct> dst = make_rgba(Type::float32);
+                    dst->field("a").flags |= Flags::default_;
+                    dst->field("a").default_value = (t % 2 == 0) ? i : 1000 * t + i;
+                    DataStructConverter converter(src, dst, Backend::vm);
+                    float result[4];
+                    converter.convert(rgb, result, 1);
+                    failures[t] += result[3] == float(dst->field("a").default_value) ? 0 : 1;
+                }
+            }
+        );
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int t = 0; t < 8; ++t)
+        CHECK(failures[t] == 0);
+}
+
+TEST_CASE("convert_benchmark" * doctest::skip(!PRINT_DIAGNOSTICS))
+{
+    const size_t count = 1024 * 1024;
+    const Flags norm = Flags::normalized;
+    const Flags srgb = Flags::normalized | Flags::srgb_gamma;
+
+    struct Benchmark {
+        const char* name;
+        ref<DataStruct> src;
+        ref<DataStruct> dst;
+    };
+
+    Benchmark benchmarks[] = {
+        {"rgba8 srgb -> rgba32f", make_rgba(Type::uint8, srgb), make_rgba(Type::float32)},
+        {"rgba32f -> rgba8 srgb", make_rgba(Type::float32), make_rgba(Type::uint8, srgb)},
+        {"rgba16 -> rgba16f", make_rgba(Type::uint16, norm), make_rgba(Type::float16)},
+        {"rgba16f -> rgba32f", make_rgba(Type::float16), make_rgba(Type::float32)},
+    };
+
+    for (const Benchmark& benchmark : benchmarks) {
+        std::vector<uint8_t> data = random_data(benchmark.src, count);
+        std::vector<uint8_t> result(benchmark.dst->size() * count);
+
+        for (Backend backend : {Backend::vm, Backend::jit, Backend::block}) {
+            ref<DataStructConverter> converter = make_ref<DataStructConverter>(benchmark.src, benchmark.dst, backend);
+            // Warm up (compiles the program).
+            converter->convert(data.data(), result.data(), 1);
+
+            Timer timer;
+            converter->convert(data.data(), result.data(), count);
+            double elapsed = timer.elapsed_s();
+#if PRINT_DIAGNOSTICS
+            fmt::println("{} ({}): {:.1f} Mstructs/s", benchmark.name, backend, count / elapsed * 1e-6);
+#else
+            (void)elapsed;
+#endif
+        }
+    }
+}
+
+TEST_SUITE_END();
@@ -4,8 +4,11 @@
 #include "sgl/core/dds_file.h"
 #include "sgl/core/platform.h"
 #include "sgl/core/memory_stream.h"
+#include "sgl/core/file_stream.h"
 #include "sgl/device/native_formats.h"
 
+#include <cstring>
+
 using namespace sgl;
 
 TEST_SUITE_BEGIN("dds_file");
@@ -409,6 +412,26 @@ TEST_CASE("formats")
     }
 }
 
+TEST_CASE("mapped_and_stream")
+{
+    std::filesystem::path images_dir = platform::project_directory() / "data" / "test_images" / "dds";
+
+    for (const TestItem& item : TEST_ITEMS) {
+        CAPTURE(item.path);
+        // Loading from path memory maps the file, loading from a stream reads it into memory.
+        DDSFile mapped_file(images_dir / item.path);
+        FileStream stream(images_dir / item.path, FileStream::Mode::read);
+        DDSFile stream_file(&stream);
+
+        REQUIRE_EQ(mapped_file.size(), stream_file.size());
+        CHECK(std::memcmp(mapped_file.data(), stream_file.data(), mapped_file.size()) == 0);
+        CHECK_EQ(
+            mapped_file.get_subresource_data(mapped_file.mip_count() - 1, 0) - mapped_file.data(),
+            stream_file.get_subresource_data(stream_file.mip_count() - 1, 0) - stream_file.data()
+        );
+    }
+}
+
 TEST_CASE("detect_dds_file")
 {
     const uint32_t VALID_MAGIC = 0x20534444;
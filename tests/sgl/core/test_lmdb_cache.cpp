@@ -160,6 +160,69 @@ TEST_CASE("simple")
     CHECK(cache.del(key1) == false);
 }
 
+TEST_CASE("batch")
+{
+    auto cache_dir = testing::get_case_temp_directory() / "cache";
+    LMDBCache cache(cache_dir);
+
+    std::vector<CacheEntry> entries = generate_random_entries(100);
+    std::vector<std::span<const uint8_t>> keys;
+    std::vector<std::span<const uint8_t>> values;
+    size_t total_size = 0;
+    for (const auto& entry : entries) {
+        keys.push_back(entry.key);
+        values.push_back(entry.value);
+        total_size += entry.value.size();
+    }
+
+    // Set all entries in a single transaction.
+    cache.set_many(keys, values);
+    CACHE_CHECK_STATS(cache, entries.size(), total_size);
+
+    // Get all entries, including some missing keys.
+    Blob missing_key = random_data(32);
+    std::vector<std::span<const uint8_t>> query_keys;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        query_keys.push_back(entries[i].key);
+        if (i % 10 == 0)
+            query_keys.push_back(missing_key);
+    }
+    std::vector<Blob> query_values(query_keys.size());
+    size_t found = cache.get_many(
+        query_keys,
+        [](size_t index, const void* data, size_t size, void* user_data)
+        {
+            auto& values = *reinterpret_cast<std::vector<Blob>*>(user_data);
+            values[index].assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        },
+        &query_values
+    );
+    CHECK(found == entries.size());
+    for (size_t i = 0, j = 0; i < query_keys.size(); ++i) {
+        if (query_keys[i].data() == missing_key.data()) {
+            CHECK(query_values[i].empty());
+        } else {
+            CHECK(query_values[i] == entries[j++].value);
+        }
+    }
+
+    // Overwrite the first entry twice in the same batch (last value wins).
+    Blob value1 = random_data(16);
+    Blob value2 = random_data(32);
+    std::span<const uint8_t> overwrite_keys[] = {entries[0].key, entries[0].key};
+    std::span<const uint8_t> overwrite_values[] = {value1, value2};
+    cache.set_many(overwrite_keys, overwrite_values);
+    CACHE_CHECK_STATS(cache, entries.size(), total_size - entries[0].value.size() + value2.size());
+    Blob value;
+    CHECK(cache.get(entries[0].key, value));
+    CHECK(value == value2);
+
+    // Empty batches.
+    CHECK(cache.get_many({}, nullptr) == 0);
+    cache.set_many({}, {});
+    CHECK_THROWS(cache.set_many(keys, {}));
+}
+
 TEST_CASE("persistence")
 {
     auto cache_dir = testing::get_case_temp_directory() / "cache";
@@ -459,4 +522,202 @@ TEST_CASE("stress-multi-threaded")
     }
 }
 
+TEST_CASE("set-latency" * doctest::skip(!PRINT_DIAGNOSTICS))
+{
+    // Measure worst-case set() latency with a large number of small entries,
+    // where eviction needs to process 100k+ entries.
+    const size_t count = 160000;
+    const size_t cache_size = 64 * 1024 * 1024;
+
+    std::vector<CacheEntry> entries = generate_random_entries(count, 32, 64, 256);
+
+    struct Mode {
+        const char* name;
+        bool background_eviction;
+        uint32_t eviction_sample_size;
+    };
+
+    Mode modes[] = {
+        {"exact", false, 0},
+        {"sampled", false, 64},
+        {"background", true, 0},
+        {"background+sampled", true, 64},
+    };
+
+    for (const Mode& mode : modes) {
+        std::string name = mode.name;
+        CAPTURE(name);
+        auto cache_dir = testing::get_case_temp_directory() / name;
+
+        std::vector<double> latencies;
+        latencies.reserve(entries.size());
+        {
+            LMDBCache cache(
+                cache_dir,
+                LMDBCache::Options{
+                    .max_size = cache_size,
+                    .background_eviction = mode.background_eviction,
+                    .eviction_sample_size = mode.eviction_sample_size,
+                }
+            );
+            for (const auto& entry : entries) {
+                Timer timer;
+                cache.set(entry.key, entry.value);
+                latencies.push_back(timer.elapsed_us());
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        double p50 = latencies[latencies.size() / 2];
+        double p99 = latencies[latencies.size() * 99 / 100];
+        double max = latencies.back();
+        if (PRINT_DIAGNOSTICS)
+            fmt::println("{}: p50={:.1f}us p99={:.1f}us max={:.1f}us", name, p50, p99, max);
+
+        // Reopen the cache (after background eviction has stopped).
+        // Values that are still in the cache need to be intact and match the stats.
+        LMDBCache cache(cache_dir, LMDBCache::Options{.max_size = cache_size});
+        size_t entry_count = 0;
+        size_t total_size = 0;
+        for (const auto& entry : entries) {
+            Blob value;
+            if (cache.get(entry.key, value)) {
+                CHECK(value == entry.value);
+                entry_count++;
+                total_size += value.size();
+            }
+        }
+        CACHE_CHECK_STATS(cache, entry_count, total_size);
+    }
+}
+
+TEST_CASE("sampled-eviction-common-prefix")
+{
+    // Keys with a long common prefix need to be sampled uniformly, so that eviction removes the least
+    // recently used entries instead of the ones with the lowest keys.
+    const size_t cache_size = 8 * 1024 * 1024;
+    auto cache_dir = testing::get_case_temp_directory() / "cache";
+    LMDBCache cache(
+        cache_dir,
+        LMDBCache::Options{
+            .max_size = cache_size,
+            .eviction_sample_size = 16,
+            // Keep access times buffered, eviction needs to write them before picking entries to evict.
+            .access_buffer_size = 1000000,
+            .access_flush_interval_ms = 1000000,
+        }
+    );
+
+    auto make_key = [](size_t index)
+    {
+        std::string key = fmt::format("shaders/modules/some/common/prefix/{:08}", index);
+        return Blob(key.begin(), key.end());
+    };
+    Blob value = random_data(2000);
+
+    // Fill the cache to just below the eviction threshold.
+    size_t count = 0;
+    while (cache.usage().used_size < cache_size * 75 / 100)
+        cache.set(make_key(count++), value);
+
+    // Access the entries with the lowest keys, making them the most recently used.
+    size_t recent_count = count / 2;
+    Blob result;
+    for (size_t i = 0; i < recent_count; ++i)
+        CHECK(cache.get(make_key(i), result));
+
+    // Add new entries to trigger eviction.
+    for (size_t i = 0; i < count / 6; ++i)
+        cache.set(make_key(count + i), value);
+    CHECK(cache.stats().evictions > 0);
+
+    // Sampling is approximate, but most evicted entries need to be old ones.
+    size_t old_count = count - recent_count;
+    size_t recent_kept = 0;
+    size_t old_kept = 0;
+    for (size_t i = 0; i < count; ++i)
+        (i < recent_count ? recent_kept : old_kept) += cache.get(make_key(i), result) ? 1 : 0;
+    if (PRINT_DIAGNOSTICS)
+        fmt::println("recent kept: {}/{} old kept: {}/{}", recent_kept, recent_count, old_kept, old_count);
+    CHECK(old_kept < old_count);
+    CHECK(recent_count - recent_kept < (old_count - old_kept) / 2);
+}
+
+TEST_CASE("access-times")
+{
+    // Reads only buffer access times. They are written by flush() or together with the next write, and are
+    // used for eviction after reopening the cache.
+    const size_t cache_size = 8 * 1024 * 1024;
+    auto cache_dir = testing::get_case_temp_directory() / "cache";
+    LMDBCache::Options options{
+        .max_size = cache_size,
+        .access_buffer_size = 1000000,
+        .access_flush_interval_ms = 1000000,
+    };
+
+    auto make_key = [](size_t index)
+    {
+        std::string key = fmt::format("entry/{:08}", index);
+        return Blob(key.begin(), key.end());
+    };
+    Blob value = random_data(2000);
+    Blob result;
+
+    size_t count = 0;
+    size_t recent_count = 0;
+
+    {
+        LMDBCache cache(cache_dir, options);
+
+        while (cache.usage().used_size < cache_size * 70 / 100)
+            cache.set(make_key(count++), value);
+
+        // Access the entries added first, making them the most recently used.
+        recent_count = count / 4;
+        uint64_t txn_id = cache.stats().last_txn_id;
+        for (size_t i = 0; i < recent_count; ++i)
+            CHECK(cache.get(make_key(i), result));
+        std::vector<Blob> keys;
+        for (size_t i = 0; i < recent_count; ++i)
+            keys.push_back(make_key(i));
+        std::vector<std::span<const uint8_t>> key_spans(keys.begin(), keys.end());
+        CHECK(cache.get_many(key_spans, [](size_t, const void*, size_t, void*) { }) == recent_count);
+        CHECK(cache.stats().last_txn_id == txn_id);
+
+        // Buffered access times are written in the same transaction as new values.
+        cache.set(make_key(count++), value);
+        CHECK(cache.stats().last_txn_id == txn_id + 1);
+
+        for (size_t i = 0; i < recent_count; ++i)
+            CHECK(cache.get(make_key(i), result));
+        CHECK(cache.stats().last_txn_id == txn_id + 1);
+
+        cache.flush();
+        CHECK(cache.stats().last_txn_id == txn_id + 2);
+
+        // Nothing left to write, closing the cache does not write access times either.
+        cache.flush();
+        CHECK(cache.stats().last_txn_id == txn_id + 2);
+    }
+
+    // Reopen the cache and add new entries until entries are evicted (exact LRU).
+    {
+        LMDBCache cache(cache_dir, options);
+
+        for (size_t i = 0; i < count && cache.stats().evictions == 0; ++i)
+            cache.set(make_key(count + i), value);
+        CHECK(cache.stats().evictions > 0);
+
+        size_t recent_kept = 0;
+        size_t old_kept = 0;
+        for (size_t i = 0; i < count; ++i)
+            (i < recent_count ? recent_kept : old_kept) += cache.get(make_key(i), result) ? 1 : 0;
+        size_t old_count = count - recent_count;
+        if (PRINT_DIAGNOSTICS)
+            fmt::println("recent kept: {}/{} old kept: {}/{}", recent_kept, recent_count, old_kept, old_count);
+        CHECK(recent_kept == recent_count);
+        CHECK(old_kept < old_count);
+    }
+}
+
 TEST_SUITE_END();
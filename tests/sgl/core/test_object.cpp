@@ -63,6 +63,28 @@ TEST_CASE("ref")
     CHECK_EQ(DummyObject::get_count(), 0);
 }
 
+TEST_CASE("try_inc_ref")
+{
+    REQUIRE_EQ(DummyObject::get_count(), 0);
+
+    ref<DummyObject> r1 = make_ref<DummyObject>();
+    CHECK(r1->try_inc_ref());
+    CHECK_EQ(r1->ref_count(), 2);
+    r1->dec_ref();
+    CHECK_EQ(r1->ref_count(), 1);
+
+    // Objects whose reference count dropped to zero are not revived.
+    DummyObject* raw = r1.get();
+    raw->inc_ref();
+    r1 = nullptr;
+    raw->dec_ref(false);
+    CHECK_EQ(raw->ref_count(), 0);
+    CHECK_FALSE(raw->try_inc_ref());
+    CHECK_EQ(raw->ref_count(), 0);
+    delete raw;
+    CHECK_EQ(DummyObject::get_count(), 0);
+}
+
 class DummyBuffer;
 
 class DummyDevice : public Object {
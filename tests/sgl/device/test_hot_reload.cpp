@@ -6,7 +6,9 @@
 #include "sgl/device/shader.h"
 #include "sgl/device/kernel.h"
 #include "sgl/device/hot_reload.h"
+#include <algorithm>
 #include <fstream>
+#include <memory>
 #include <filesystem>
 #include <thread>
 #include <chrono>
@@ -466,6 +468,74 @@ TEST_CASE_GPU("change_program_and_auto_detect_changes")
     CHECK(!ctx.device->_hot_reload()->last_build_failed());
 }
 
+TEST_CASE_GPU("only_recreate_sessions_depending_on_changed_files")
+{
+    ctx.device->_hot_reload()->set_auto_detect_changes(true);
+    ctx.device->_hot_reload()->set_auto_detect_delay(25);
+    ctx.device->_hot_reload()->_clear_file_watches();
+
+    // Write two shaders in separate directories and load them in separate sessions.
+    auto dir = testing::get_case_temp_directory();
+    std::filesystem::create_directories(dir / "a");
+    std::filesystem::create_directories(dir / "b");
+    auto path_a = dir / "a" / "sessiona.slang";
+    auto path_b = dir / "b" / "sessionb.slang";
+    write_shader({.path = path_a, .set_to = "1"});
+    write_shader({.path = path_b, .set_to = "1"});
+
+    ref<ShaderProgram> program_a = ctx.device->load_program(path_a.string(), {"compute_main"});
+    ref<ComputeKernel> kernel_a = ctx.device->create_compute_kernel({.program = program_a});
+    ref<SlangSession> session_b = ctx.device->create_slang_session({});
+    ref<ShaderProgram> program_b = session_b->load_program(path_b.string(), {"compute_main"});
+    ref<ComputeKernel> kernel_b = ctx.device->create_compute_kernel({.program = program_b});
+    CHECK(run_and_verify(ctx, kernel_a, 1));
+    CHECK(run_and_verify(ctx, kernel_b, 1));
+
+    // Record the last hot reload event.
+    // The callback stays registered on the shared device, so it only keeps a weak reference to the record
+    // and the record does not keep the recreated sessions alive.
+    struct EventRecord {
+        std::vector<const SlangSession*> sessions;
+        std::vector<std::filesystem::path> changed_files;
+    };
+    auto last_event = std::make_shared<EventRecord>();
+    ctx.device->register_shader_hot_reload_callback(
+        [weak_event = std::weak_ptr<EventRecord>(last_event)](const ShaderHotReloadEvent& event)
+        {
+            auto record = weak_event.lock();
+            if (!record)
+                return;
+            record->sessions.clear();
+            for (const ref<SlangSession>& session : event.sessions)
+                record->sessions.push_back(session.get());
+            record->changed_files = event.changed_files;
+        }
+    );
+
+    // Re-write the second shader so it returns 2 and wait for it to reload.
+    ctx.device->_hot_reload()->_reset_reloaded();
+    write_shader({.path = path_b, .set_to = "2"});
+    for (int i = 0; i < 400 && !ctx.device->_hot_reload()->_has_reloaded(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        ctx.device->_hot_reload()->update();
+    }
+    CHECK(!ctx.device->_hot_reload()->last_build_failed());
+
+    // Only the second session should have been recreated.
+    REQUIRE(last_event->sessions.size() == 1);
+    CHECK(last_event->sessions[0] == session_b.get());
+    auto changed = std::filesystem::absolute(path_b).lexically_normal().make_preferred();
+    CHECK(std::find(last_event->changed_files.begin(), last_event->changed_files.end(), changed)
+          != last_event->changed_files.end());
+    CHECK(run_and_verify(ctx, kernel_a, 1));
+    CHECK(run_and_verify(ctx, kernel_b, 2));
+
+    // Forced reloads recreate all sessions.
+    ctx.device->_hot_reload()->recreate_all_sessions();
+    CHECK(last_event->sessions.size() >= 2);
+    CHECK(last_event->changed_files.empty());
+}
+
 /// SKIPPED: This test is flaky on CI, and needs to be reworked.
 TEST_CASE_GPU("create_multi_directory_session_and_monitor_for_changes" * doctest::skip())
 {
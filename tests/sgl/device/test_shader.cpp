@@ -3,11 +3,61 @@
 #include "testing.h"
 #include "sgl/device/device.h"
 #include "sgl/device/shader.h"
+#include "sgl/device/pipeline.h"
+#include "sgl/device/reflection.h"
+#include "sgl/core/thread.h"
+#include <atomic>
+#include <mutex>
 #include <fstream>
 #include <filesystem>
 
 using namespace sgl;
 
+namespace {
+/// Stand-in for Python reference counting, using a recursive mutex as the GIL.
+struct FakePyObject {
+    Py_ssize_t_ ref_count;
+    const Object* object;
+};
+
+std::recursive_mutex s_fake_gil;
+
+void install_fake_python()
+{
+    object_init_py(
+        [](PyObject* o) noexcept
+        {
+            std::lock_guard lock(s_fake_gil);
+            reinterpret_cast<FakePyObject*>(o)->ref_count++;
+        },
+        [](PyObject* o) noexcept
+        {
+            std::lock_guard lock(s_fake_gil);
+            FakePyObject* fake = reinterpret_cast<FakePyObject*>(o);
+            // Like Python, deallocate the object while holding the GIL.
+            if (--fake->ref_count == 0) {
+                delete fake->object;
+                delete fake;
+            }
+        },
+        [](PyObject* o) noexcept -> Py_ssize_t_
+        {
+            std::lock_guard lock(s_fake_gil);
+            return reinterpret_cast<FakePyObject*>(o)->ref_count;
+        },
+        []() noexcept -> int
+        {
+            s_fake_gil.lock();
+            return 0;
+        },
+        [](int) noexcept
+        {
+            s_fake_gil.unlock();
+        }
+    );
+}
+} // namespace
+
 /// Setup code for the shader test writes out some simple modules.
 static void setup_testshader_files(const std::filesystem::path& dir)
 {
@@ -107,6 +157,85 @@ TEST_CASE_GPU("shader")
         CHECK_EQ(paths[1].filename(), "_testshader_struct.slang");
         CHECK_EQ(paths[2].filename(), "print.slang");
     }
+
+    // Load modules, link programs and create pipelines from many threads, in one and in separate sessions.
+    SUBCASE("concurrent_pipelines")
+    {
+        std::vector<ref<SlangSession>> sessions{ref(ctx.device->slang_session()), ctx.device->create_slang_session({})};
+        std::atomic<uint32_t> failures{0};
+        thread::parallel_for(
+            thread::blocked_range<uint32_t>(0, 32),
+            [&](const thread::blocked_range<uint32_t>& range)
+            {
+                SlangSession* session = sessions[range.begin() % sessions.size()];
+                ref<SlangModule> module = session->load_module((dir / "_testshader_simple.slang").string());
+                ref<ShaderProgram> program = session->link_program({module}, {module->entry_point("main_a")});
+                ref<ComputePipeline> pipeline = ctx.device->create_compute_pipeline({.program = program});
+                std::vector<ref<ComputePipeline>> batch = ctx.device->create_compute_pipelines({
+                    {.program = program},
+                    {.program = program, .defer_target_compilation = true},
+                });
+                if (!pipeline || batch.size() != 2 || !batch[0] || !batch[1])
+                    failures++;
+            }
+        );
+        CHECK_EQ(failures, 0);
+    }
+
+    // Look up reflection wrappers from many threads, while they are concurrently created and destroyed.
+    SUBCASE("concurrent_reflection")
+    {
+        ref<SlangModule> module = ctx.device->load_module((dir / "_testshader_simple.slang").string());
+        slang::TypeReflection* foo = module->layout()->find_type_by_name("Foo")->slang_target();
+
+        std::atomic<uint32_t> mismatches{0};
+        thread::parallel_for(
+            thread::blocked_range<uint32_t>(0, 64),
+            [&](const thread::blocked_range<uint32_t>&)
+            {
+                for (uint32_t i = 0; i < 1000; ++i) {
+                    ref<const TypeReflection> a = detail::from_slang(module, foo);
+                    ref<const TypeReflection> b = detail::from_slang(module, foo);
+                    if (a != b || a->slang_target() != foo)
+                        mismatches++;
+                }
+            }
+        );
+        CHECK_EQ(mismatches, 0);
+    }
+
+    // Same as above, but with some threads holding the (fake) GIL and handing wrappers over to Python,
+    // which then deallocates them while holding the GIL.
+    SUBCASE("concurrent_reflection_py")
+    {
+        ref<SlangModule> module = ctx.device->load_module((dir / "_testshader_simple.slang").string());
+        slang::TypeReflection* foo = module->layout()->find_type_by_name("Foo")->slang_target();
+
+        install_fake_python();
+        std::atomic<uint32_t> mismatches{0};
+        thread::parallel_for(
+            thread::blocked_range<uint32_t>(0, 64),
+            [&](const thread::blocked_range<uint32_t>& range)
+            {
+                bool python_thread = range.begin() % 2 == 0;
+                for (uint32_t i = 0; i < 1000; ++i) {
+                    std::unique_lock gil(s_fake_gil, std::defer_lock);
+                    if (python_thread)
+                        gil.lock();
+                    ref<const TypeReflection> a = detail::from_slang(module, foo);
+                    ref<const TypeReflection> b = detail::from_slang(module, foo);
+                    if (a != b || a->slang_target() != foo)
+                        mismatches++;
+                    if (python_thread && !a->self_py())
+                        const_cast<TypeReflection*>(a.get())->set_self_py(
+                            reinterpret_cast<PyObject*>(new FakePyObject{0, a.get()})
+                        );
+                }
+            }
+        );
+        object_init_py(nullptr, nullptr, nullptr);
+        CHECK_EQ(mismatches, 0);
+    }
 }
 
 TEST_SUITE_END();